@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Compile-time benchmark: `#include <dynamicxx/dynamicxx.h>` vs `import dynamicxx;`.
+
+Generates a throwaway CMake project with the same number of translation units
+in two flavours, one including the header and one importing the module, then
+times a serial build of each. The module interface itself is built once up
+front and reported separately, since a real project pays for it only once.
+
+Needs CMake 3.28 or later, the Ninja generator and a compiler with C++20
+module support.
+
+Usage:
+    compile_time.py --units 100 --repetitions 3 [--cxx clang++]
+"""
+
+import argparse
+import pathlib
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+REPO = pathlib.Path(__file__).resolve().parent.parent
+
+# Representative use of the library: build, mutate, copy and compare a small
+# document, which instantiates most of BasicDynamic.
+BODY = """
+int Use{index}() {{
+    auto d = dynamicxx::Dynamic::From<dynamicxx::Dynamic::Object>();
+    d["id"] = {index};
+    d["name"] = "unit {index}";
+    d["values"] = dynamicxx::Dynamic::From<dynamicxx::Dynamic::Array>();
+    d["values"].Push(1.5);
+    const auto copy = d.Clone();
+    return copy == d ? static_cast<int>(d.size()) : 0;
+}}
+"""
+
+CMAKELISTS = """cmake_minimum_required(VERSION 3.28)
+project(dynamicxx_compile_time CXX)
+
+set(CMAKE_CXX_STANDARD 20)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+set(CMAKE_CXX_EXTENSIONS OFF)
+
+set(DYNAMICXX_BUILD_MODULE ON CACHE BOOL "" FORCE)
+add_subdirectory("{repo}" dynamicxx)
+
+add_library(with_include OBJECT {include_sources})
+target_link_libraries(with_include PRIVATE dynamicxx)
+
+add_library(with_import OBJECT {import_sources})
+target_link_libraries(with_import PRIVATE dynamicxx_module)
+"""
+
+
+def generate(project, units):
+    include_sources = []
+    import_sources = []
+    for index in range(units):
+        name = "include_{}.cc".format(index)
+        (project / name).write_text("#include <dynamicxx/dynamicxx.h>\n" +
+                                    BODY.format(index=index))
+        include_sources.append(name)
+
+        name = "import_{}.cc".format(index)
+        (project / name).write_text("import dynamicxx;\n" +
+                                    BODY.format(index=index))
+        import_sources.append(name)
+
+    (project / "CMakeLists.txt").write_text(
+        CMAKELISTS.format(repo=REPO.as_posix(),
+                          include_sources=" ".join(include_sources),
+                          import_sources=" ".join(import_sources)))
+
+
+def build(build_dir, target):
+    start = time.perf_counter()
+    subprocess.run(["cmake", "--build", str(build_dir), "--target", target,
+                    "-j", "1"],
+                   check=True, stdout=subprocess.DEVNULL)
+    return time.perf_counter() - start
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--units", type=int, default=100,
+                        help="translation units per flavour")
+    parser.add_argument("--repetitions", type=int, default=3)
+    parser.add_argument("--cxx", help="C++ compiler to use")
+    parser.add_argument("--build-type", default="Debug")
+    parser.add_argument("--keep", action="store_true",
+                        help="keep the generated project")
+    args = parser.parse_args()
+
+    project = pathlib.Path(tempfile.mkdtemp(prefix="dynamicxx_compile_"))
+    build_dir = project / "build"
+    try:
+        generate(project, args.units)
+
+        configure = ["cmake", "-S", str(project), "-B", str(build_dir),
+                     "-G", "Ninja",
+                     "-DCMAKE_BUILD_TYPE={}".format(args.build_type)]
+        if args.cxx:
+            configure.append("-DCMAKE_CXX_COMPILER={}".format(args.cxx))
+        subprocess.run(configure, check=True, stdout=subprocess.DEVNULL)
+
+        module_time = build(build_dir, "dynamicxx_module")
+
+        times = {"with_include": [], "with_import": []}
+        for _ in range(args.repetitions):
+            for target, samples in times.items():
+                shutil.rmtree(build_dir / "CMakeFiles" /
+                              "{}.dir".format(target),
+                              ignore_errors=True)
+                samples.append(build(build_dir, target))
+
+        print("Module interface (built once): {:.2f} s".format(module_time))
+        for target, samples in times.items():
+            median = statistics.median(samples)
+            print("{:<13} {:>8.2f} s total  {:>8.1f} ms per unit".format(
+                target, median, 1000.0 * median / args.units))
+
+        ratio = (statistics.median(times["with_include"]) /
+                 statistics.median(times["with_import"]))
+        print("import is {:.2f}x the speed of include".format(ratio))
+    finally:
+        if args.keep:
+            print("Project kept in {}".format(project))
+        else:
+            shutil.rmtree(project, ignore_errors=True)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,578 @@
+#include <benchmark/benchmark.h>
+#include <dynamicxx/binary.h>
+#include <dynamicxx/cache.h>
+#include <dynamicxx/dictionary.h>
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/numeric.h>
+#include <dynamicxx/ordered_map.h>
+#include <dynamicxx/queue.h>
+#include <dynamicxx/shared_memory.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using dynamicxx::Dynamic;
+using dynamicxx::DynamicManaged;
+using dynamicxx::OrderedDynamic;
+
+namespace {
+
+// --- Document shapes ---
+// Each shape approximates a kind of document seen in practice, so that
+// container policy decisions can be made against realistic workloads.
+
+// A single record: a couple of dozen scalar fields of mixed types.
+template <class DynamicType>
+DynamicType MakeFlat() {
+    auto d = DynamicType::template From<typename DynamicType::Object>();
+    for (int i = 0; i < 8; ++i) {
+        const auto suffix = std::to_string(i);
+        d[("id_" + suffix).c_str()] = i * 1000;
+        d[("name_" + suffix).c_str()] = "name value " + suffix;
+        d[("ratio_" + suffix).c_str()] = i * 0.25;
+        d[("enabled_" + suffix).c_str()] = (i % 2) == 0;
+    }
+    return d;
+}
+
+// A chain of nested objects, each level carrying a little payload.
+template <class DynamicType>
+DynamicType MakeDeep() {
+    static constexpr int Depth = 64;
+
+    auto root = DynamicType::template From<typename DynamicType::Object>();
+    DynamicType* current = &root;
+    for (int i = 0; i < Depth; ++i) {
+        (*current)["level"] = i;
+        (*current)["label"] = "nested level";
+        (*current)["child"] =
+            DynamicType::template From<typename DynamicType::Object>();
+        current = &(*current)["child"];
+    }
+    return root;
+}
+
+// An array of many small records, as in a result set or a log batch.
+template <class DynamicType>
+DynamicType MakeWide() {
+    static constexpr int Records = 1000;
+
+    auto d = DynamicType::template From<typename DynamicType::Array>();
+    for (int i = 0; i < Records; ++i) {
+        auto record = DynamicType::template From<typename DynamicType::Object>();
+        record["id"] = i;
+        record["level"] = (i % 3) == 0 ? "info" : "debug";
+        record["latency"] = i * 0.5;
+        d.GetArray().push_back(std::move(record));
+    }
+    return d;
+}
+
+// A large array of scalars, as in metrics or time series documents.
+template <class DynamicType>
+DynamicType MakeNumeric() {
+    static constexpr int Values = 10000;
+
+    auto d = DynamicType::template From<typename DynamicType::Array>();
+    for (int i = 0; i < Values; ++i) {
+        if (i % 2 == 0) {
+            d.Push(i);
+        } else {
+            d.Push(i * 1.5);
+        }
+    }
+    return d;
+}
+
+// --- Construction ---
+
+void BM_FromInteger(benchmark::State& state) {
+    for (auto _ : state) {
+        auto d = Dynamic::From<Dynamic::Integer>(42);
+        benchmark::DoNotOptimize(d);
+    }
+}
+BENCHMARK(BM_FromInteger);
+
+void BM_FromString(benchmark::State& state) {
+    const std::string value(static_cast<std::size_t>(state.range(0)), 'x');
+    for (auto _ : state) {
+        auto d = Dynamic::From<Dynamic::String>(value);
+        benchmark::DoNotOptimize(d);
+    }
+}
+BENCHMARK(BM_FromString)->Arg(8)->Arg(64)->Arg(1024);
+
+void BM_OfInteger(benchmark::State& state) {
+    for (auto _ : state) {
+        auto d = Dynamic::Of(42);
+        benchmark::DoNotOptimize(d);
+    }
+}
+BENCHMARK(BM_OfInteger);
+
+void BM_OfString(benchmark::State& state) {
+    for (auto _ : state) {
+        auto d = Dynamic::Of("a short string");
+        benchmark::DoNotOptimize(d);
+    }
+}
+BENCHMARK(BM_OfString);
+
+void BM_EmplaceReplace(benchmark::State& state) {
+    Dynamic d = Dynamic::From<Dynamic::String>("initial value");
+    for (auto _ : state) {
+        d.Emplace<Dynamic::Integer>(42);
+        d.Emplace<Dynamic::Number>(1.5);
+        benchmark::DoNotOptimize(d);
+    }
+}
+BENCHMARK(BM_EmplaceReplace);
+
+// --- Mutation ---
+
+void BM_PushIntegers(benchmark::State& state) {
+    const auto count = state.range(0);
+    for (auto _ : state) {
+        Dynamic d = Dynamic::From<Dynamic::Array>();
+        for (std::int64_t i = 0; i < count; ++i) {
+            d.Push(i);
+        }
+        benchmark::DoNotOptimize(d);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_PushIntegers)->Arg(16)->Arg(1024);
+
+void BM_PushStrings(benchmark::State& state) {
+    const auto count = state.range(0);
+    for (auto _ : state) {
+        Dynamic d = Dynamic::From<Dynamic::Array>();
+        for (std::int64_t i = 0; i < count; ++i) {
+            d.Push("string element");
+        }
+        benchmark::DoNotOptimize(d);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_PushStrings)->Arg(16)->Arg(1024);
+
+// Keys arrive in no particular order, as from a parser.
+std::vector<std::string> ShuffledKeys(const std::int64_t count) {
+    std::vector<std::string> keys;
+    for (std::int64_t i = 0; i < count; ++i) {
+        keys.push_back("field_" + std::to_string((i * 7919) % count));
+    }
+    return keys;
+}
+
+void BM_InsertKeys(benchmark::State& state) {
+    const auto keys = ShuffledKeys(state.range(0));
+    for (auto _ : state) {
+        Dynamic d = Dynamic::From<Dynamic::Object>();
+        for (const auto& key : keys) {
+            d[key.c_str()] = 1;
+        }
+        benchmark::DoNotOptimize(d);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InsertKeys)->Arg(16)->Arg(512);
+
+void BM_BuildObject(benchmark::State& state) {
+    const auto keys = ShuffledKeys(state.range(0));
+    for (auto _ : state) {
+        Dynamic::ObjectBuilder builder;
+        builder.Reserve(keys.size());
+        for (const auto& key : keys) {
+            builder.Add(key, 1);
+        }
+        benchmark::DoNotOptimize(builder.Finish());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BuildObject)->Arg(16)->Arg(512);
+
+// --- Parsing ---
+
+void BM_ParseInteger(benchmark::State& state) {
+    const std::string text = "1234567890123456789";
+    for (auto _ : state) {
+        std::uint64_t value = 0;
+        benchmark::DoNotOptimize(dynamicxx::ParseInteger(
+            text.data(), text.data() + text.size(), value));
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_ParseInteger);
+
+void BM_ParseNumber(benchmark::State& state) {
+    const char* const numbers[] = {"3.14159265358979", "-0.000123",
+                                   "6.02214076e23", "42",
+                                   "1.7976931348623157e308"};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        double value = 0;
+        const char* text = numbers[i];
+        benchmark::DoNotOptimize(dynamicxx::ParseNumber(
+            text, text + std::strlen(text), value));
+        benchmark::DoNotOptimize(value);
+        i = (i + 1) % 5;
+    }
+}
+BENCHMARK(BM_ParseNumber);
+
+// --- Access ---
+
+void BM_ArrayIndex(benchmark::State& state) {
+    const Dynamic d = MakeNumeric<Dynamic>();
+    const auto size = d.size();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(d[i]);
+        if (++i == size) {
+            i = 0;
+        }
+    }
+}
+BENCHMARK(BM_ArrayIndex);
+
+void BM_ArrayIndexString(benchmark::State& state) {
+    const Dynamic d = MakeNumeric<Dynamic>();
+    const char* const keys[] = {"0", "17", "255", "1000"};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(d[keys[i]]);
+        i = (i + 1) % 4;
+    }
+}
+BENCHMARK(BM_ArrayIndexString);
+
+void BM_ObjectLookupLiteral(benchmark::State& state) {
+    const Dynamic d = MakeFlat<Dynamic>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(d["name_3"]);
+    }
+}
+BENCHMARK(BM_ObjectLookupLiteral);
+
+void BM_ObjectLookupString(benchmark::State& state) {
+    const Dynamic d = MakeFlat<Dynamic>();
+    const std::string key = "ratio_5";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(d[key.c_str()]);
+    }
+}
+BENCHMARK(BM_ObjectLookupString);
+
+// Metrics documents keyed by numeric IDs: every lookup formats the key.
+void BM_ObjectLookupInteger(benchmark::State& state) {
+    Dynamic d = Dynamic::From<Dynamic::Object>();
+    for (std::int64_t id = 0; id < 1024; ++id) {
+        d[id * 7919] = id;
+    }
+    const Dynamic& metrics = d;
+    std::int64_t id = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(metrics[id * 7919]);
+        id = (id + 1) & 1023;
+    }
+}
+BENCHMARK(BM_ObjectLookupInteger);
+
+void BM_ObjectContains(benchmark::State& state) {
+    const Dynamic d = MakeFlat<Dynamic>();
+    const std::string present = "id_7";
+    const std::string absent = "missing";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(d.Contains(present));
+        benchmark::DoNotOptimize(d.Contains(absent));
+    }
+}
+BENCHMARK(BM_ObjectContains);
+
+void BM_DeepPathLookup(benchmark::State& state) {
+    const Dynamic d = MakeDeep<Dynamic>();
+    for (auto _ : state) {
+        const Dynamic* current = &d;
+        while (current->Contains("child")) {
+            current = &(*current)["child"];
+        }
+        benchmark::DoNotOptimize(current);
+    }
+}
+BENCHMARK(BM_DeepPathLookup);
+
+// --- Whole-document operations ---
+
+template <class DynamicType>
+void BM_Clone(benchmark::State& state, DynamicType (*make)()) {
+    const DynamicType d = make();
+    for (auto _ : state) {
+        auto clone = d.Clone();
+        benchmark::DoNotOptimize(clone);
+    }
+}
+BENCHMARK_CAPTURE(BM_Clone, flat, &MakeFlat<Dynamic>);
+BENCHMARK_CAPTURE(BM_Clone, deep, &MakeDeep<Dynamic>);
+BENCHMARK_CAPTURE(BM_Clone, wide, &MakeWide<Dynamic>);
+BENCHMARK_CAPTURE(BM_Clone, numeric, &MakeNumeric<Dynamic>);
+BENCHMARK_CAPTURE(BM_Clone, managed_wide, &MakeWide<DynamicManaged>);
+BENCHMARK_CAPTURE(BM_Clone, ordered_wide, &MakeWide<OrderedDynamic>);
+
+template <class DynamicType>
+void BM_Equals(benchmark::State& state, DynamicType (*make)()) {
+    const DynamicType lhs = make();
+    const DynamicType rhs = make();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs.Equals(rhs));
+    }
+}
+BENCHMARK_CAPTURE(BM_Equals, flat, &MakeFlat<Dynamic>);
+BENCHMARK_CAPTURE(BM_Equals, deep, &MakeDeep<Dynamic>);
+BENCHMARK_CAPTURE(BM_Equals, wide, &MakeWide<Dynamic>);
+BENCHMARK_CAPTURE(BM_Equals, numeric, &MakeNumeric<Dynamic>);
+BENCHMARK_CAPTURE(BM_Equals, ordered_wide, &MakeWide<OrderedDynamic>);
+
+template <class DynamicType>
+void BM_EncodeBinary(benchmark::State& state, DynamicType (*make)()) {
+    const DynamicType d = make();
+    std::string bytes;
+    for (auto _ : state) {
+        bytes.clear();
+        dynamicxx::EncodeBinary(d, bytes);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<std::int64_t>(bytes.size()));
+}
+BENCHMARK_CAPTURE(BM_EncodeBinary, flat, &MakeFlat<Dynamic>);
+BENCHMARK_CAPTURE(BM_EncodeBinary, wide, &MakeWide<Dynamic>);
+BENCHMARK_CAPTURE(BM_EncodeBinary, numeric, &MakeNumeric<Dynamic>);
+
+void BM_EncodeBinaryDictionary(benchmark::State& state) {
+    const auto d = MakeWide<Dynamic>();
+    std::string bytes;
+    for (auto _ : state) {
+        bytes.clear();
+        dynamicxx::EncodeBinary(d, bytes,
+                                dynamicxx::StringEncoding::Dictionary);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<std::int64_t>(bytes.size()));
+}
+BENCHMARK(BM_EncodeBinaryDictionary);
+
+template <class DynamicType>
+void BM_DecodeBinary(benchmark::State& state, DynamicType (*make)()) {
+    const auto bytes = dynamicxx::EncodeBinary(make());
+    for (auto _ : state) {
+        auto d = dynamicxx::DecodeBinary<DynamicType>(bytes);
+        benchmark::DoNotOptimize(d);
+    }
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<std::int64_t>(bytes.size()));
+}
+BENCHMARK_CAPTURE(BM_DecodeBinary, flat, &MakeFlat<Dynamic>);
+BENCHMARK_CAPTURE(BM_DecodeBinary, wide, &MakeWide<Dynamic>);
+BENCHMARK_CAPTURE(BM_DecodeBinary, numeric, &MakeNumeric<Dynamic>);
+
+// Writing a document into a shared memory segment, and reading it back.
+template <class DynamicType>
+void BM_Freeze(benchmark::State& state, DynamicType (*make)()) {
+    const DynamicType d = make();
+    std::vector<std::uint64_t> segment(1 << 20);
+    for (auto _ : state) {
+        dynamicxx::SegmentArena arena(segment.data(),
+                                      segment.size() * sizeof(std::uint64_t));
+        arena.Publish(dynamicxx::Freeze(d, arena));
+        benchmark::DoNotOptimize(segment.data());
+    }
+}
+BENCHMARK_CAPTURE(BM_Freeze, flat, &MakeFlat<Dynamic>);
+BENCHMARK_CAPTURE(BM_Freeze, wide, &MakeWide<Dynamic>);
+
+template <class DynamicType>
+void BM_Thaw(benchmark::State& state, DynamicType (*make)()) {
+    std::vector<std::uint64_t> segment(1 << 20);
+    dynamicxx::SegmentArena arena(segment.data(),
+                                  segment.size() * sizeof(std::uint64_t));
+    arena.Publish(dynamicxx::Freeze(make(), arena));
+    const auto root = dynamicxx::ReadSegment(arena.Base(), arena.Capacity());
+    for (auto _ : state) {
+        auto thawed = root.template Thaw<DynamicType>();
+        benchmark::DoNotOptimize(thawed);
+    }
+}
+BENCHMARK_CAPTURE(BM_Thaw, flat, &MakeFlat<Dynamic>);
+BENCHMARK_CAPTURE(BM_Thaw, wide, &MakeWide<Dynamic>);
+
+template <class DynamicType>
+void BM_Copy(benchmark::State& state, DynamicType (*make)()) {
+    const DynamicType d = make();
+    for (auto _ : state) {
+        DynamicType copy = d;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK_CAPTURE(BM_Copy, flat, &MakeFlat<Dynamic>);
+BENCHMARK_CAPTURE(BM_Copy, wide, &MakeWide<Dynamic>);
+BENCHMARK_CAPTURE(BM_Copy, managed_wide, &MakeWide<DynamicManaged>);
+
+template <class DynamicType>
+void BM_Move(benchmark::State& state, DynamicType (*make)()) {
+    DynamicType d = make();
+    for (auto _ : state) {
+        DynamicType moved = std::move(d);
+        d = std::move(moved);
+        benchmark::DoNotOptimize(d);
+    }
+}
+BENCHMARK_CAPTURE(BM_Move, flat, &MakeFlat<Dynamic>);
+BENCHMARK_CAPTURE(BM_Move, wide, &MakeWide<Dynamic>);
+BENCHMARK_CAPTURE(BM_Move, managed_wide, &MakeWide<DynamicManaged>);
+
+// Documents are built outside of the timed region in batches, so that only
+// the destruction of each batch is measured.
+template <class DynamicType>
+void BM_Destroy(benchmark::State& state, DynamicType (*make)()) {
+    static constexpr std::size_t BatchSize = 16;
+
+    const DynamicType prototype = make();
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<DynamicType> batch;
+        batch.reserve(BatchSize);
+        for (std::size_t i = 0; i < BatchSize; ++i) {
+            batch.push_back(prototype.Clone());
+        }
+        state.ResumeTiming();
+
+        batch.clear();
+        benchmark::DoNotOptimize(batch);
+    }
+    state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+BENCHMARK_CAPTURE(BM_Destroy, flat, &MakeFlat<Dynamic>);
+BENCHMARK_CAPTURE(BM_Destroy, deep, &MakeDeep<Dynamic>);
+BENCHMARK_CAPTURE(BM_Destroy, wide, &MakeWide<Dynamic>);
+BENCHMARK_CAPTURE(BM_Destroy, numeric, &MakeNumeric<Dynamic>);
+
+// --- Dictionary encoding ---
+// Counting records by a low-cardinality string field.
+
+void BM_GroupByString(benchmark::State& state) {
+    const auto d = MakeWide<Dynamic>();
+    for (auto _ : state) {
+        std::unordered_map<std::string, int> counts;
+        for (const auto& record : d.GetArray()) {
+            ++counts[record["level"].GetString()];
+        }
+        benchmark::DoNotOptimize(counts);
+    }
+}
+BENCHMARK(BM_GroupByString);
+
+void BM_GroupByCode(benchmark::State& state) {
+    auto d = MakeWide<Dynamic>();
+    dynamicxx::StringDictionary dictionary;
+    dictionary.Encode(d);
+    for (auto _ : state) {
+        std::vector<int> counts(dictionary.size());
+        for (const auto& record : d.GetArray()) {
+            ++counts[dictionary.CodeOf(record["level"].GetStringView())];
+        }
+        benchmark::DoNotOptimize(counts.data());
+    }
+}
+BENCHMARK(BM_GroupByCode);
+
+// --- Caching ---
+// Reading a cached record, as a handle to the shared document, against a map
+// guarded by one mutex that copies the document out.
+
+void BM_MutexMapGet(benchmark::State& state) {
+    std::mutex mutex;
+    std::unordered_map<std::string, Dynamic> map;
+    for (int i = 0; i < 1024; ++i) {
+        map["record_" + std::to_string(i)] = MakeFlat<Dynamic>();
+    }
+    const std::string key = "record_512";
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto copy = map.at(key).Clone();
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_MutexMapGet);
+
+void BM_CacheGet(benchmark::State& state) {
+    dynamicxx::DynamicCache<std::string> cache;
+    for (int i = 0; i < 1024; ++i) {
+        (void)cache.Put("record_" + std::to_string(i), MakeFlat<Dynamic>());
+    }
+    const std::string key = "record_512";
+    for (auto _ : state) {
+        auto handle = cache.Get(key);
+        benchmark::DoNotOptimize(handle);
+    }
+}
+BENCHMARK(BM_CacheGet);
+
+// --- Queues ---
+// Messages passed through a queue and back out on one thread, which measures
+// the cost of the queue itself rather than of contention.
+
+void BM_MutexDequeRoundTrip(benchmark::State& state) {
+    std::mutex mutex;
+    std::deque<Dynamic> queue;
+    const auto batch = state.range(0);
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < batch; ++i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(Dynamic::Of(i));
+        }
+        for (std::int64_t i = 0; i < batch; ++i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto message = std::move(queue.front());
+            queue.pop_front();
+            benchmark::DoNotOptimize(message);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_MutexDequeRoundTrip)->Arg(1)->Arg(64);
+
+template <class Queue>
+void BM_QueueRoundTrip(benchmark::State& state) {
+    Queue queue(1024);
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    std::vector<Dynamic> messages(batch);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < batch; ++i) {
+            messages[i] = Dynamic::Of(static_cast<std::int64_t>(i));
+        }
+        queue.TryPushBatch(messages.begin(), batch);
+        messages.clear();
+        queue.TryPopBatch(std::back_inserter(messages), batch);
+        benchmark::DoNotOptimize(messages.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_QueueRoundTrip, dynamicxx::SpscQueue<Dynamic>)
+    ->Arg(1)
+    ->Arg(64);
+BENCHMARK_TEMPLATE(BM_QueueRoundTrip, dynamicxx::MpscQueue<Dynamic>)
+    ->Arg(1)
+    ->Arg(64);
+
+}  // namespace
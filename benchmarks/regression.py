@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+"""Benchmark regression gate for dynamicxx.
+
+Runs the benchmark executable with repetitions, summarises every benchmark as
+the median and the median absolute deviation (MAD) of its repetitions, and
+compares the summary against a checked-in baseline.
+
+Every benchmark must have a baseline entry: a benchmark missing from the
+baseline fails the run, so new benchmarks are recorded in the same change that
+adds them. Baselines must come from an optimized build; --update refuses to
+record one from a debug build.
+
+A benchmark regresses only when its median is slower than the baseline by more
+than the relative threshold AND the difference is larger than a multiple of
+the observed noise (the scaled MAD of either run). Both conditions are needed:
+the first ignores changes too small to matter, the second ignores changes that
+are within the run-to-run noise of a benchmark.
+
+Usage:
+    regression.py --benchmark build/Release/benchmarks/run_benchmarks \\
+                  --baseline benchmarks/baseline.json --build-type Release
+
+    # Record a new baseline (on the machine that runs the gate):
+    regression.py --benchmark ... --baseline benchmarks/baseline.json \\
+                  --build-type Release --update
+"""
+
+import argparse
+import json
+import re
+import statistics
+import subprocess
+import sys
+import tempfile
+
+# Scales the MAD so that it estimates the standard deviation of normally
+# distributed samples.
+MAD_TO_SIGMA = 1.4826
+
+BASELINE_VERSION = 1
+
+# Recorded with every run so a baseline shows how it was produced.
+CONTEXT_KEYS = ("host_name", "num_cpus", "mhz_per_cpu", "library_build_type",
+                "dynamicxx_build_type")
+
+# Build types that are compiled without optimization.
+DEBUG_BUILD_TYPES = ("", "debug")
+
+
+def run_benchmarks(executable, repetitions, min_time, benchmark_filter,
+                   build_type, output):
+    command = [
+        executable,
+        "--benchmark_repetitions={}".format(repetitions),
+        "--benchmark_out={}".format(output),
+        "--benchmark_out_format=json",
+        "--benchmark_display_aggregates_only=true",
+    ]
+    if build_type is not None:
+        command.append(
+            "--benchmark_context=dynamicxx_build_type={}".format(build_type))
+    if min_time is not None:
+        command.append("--benchmark_min_time={}".format(min_time))
+    if benchmark_filter:
+        command.append("--benchmark_filter={}".format(benchmark_filter))
+    subprocess.run(command, check=True)
+
+    with open(output, encoding="utf-8") as f:
+        return json.load(f)
+
+
+def to_nanoseconds(value, unit):
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    return value * scale[unit]
+
+
+def summarise(results, metric):
+    """Reduces raw repetitions to {name: {median, mad, repetitions}}."""
+    samples = {}
+    for run in results["benchmarks"]:
+        # Aggregates (mean, median, stddev, ...) are recomputed from the
+        # individual repetitions below, so only those are kept.
+        if run.get("run_type", "iteration") != "iteration":
+            continue
+        name = run.get("run_name", run["name"])
+        value = to_nanoseconds(run[metric], run.get("time_unit", "ns"))
+        samples.setdefault(name, []).append(value)
+
+    summary = {}
+    for name, values in samples.items():
+        median = statistics.median(values)
+        mad = statistics.median(abs(value - median) for value in values)
+        summary[name] = {
+            "median_ns": median,
+            "mad_ns": mad,
+            "repetitions": len(values),
+        }
+    return summary
+
+
+def context_of(results):
+    context = results.get("context", {})
+    return {key: context.get(key) for key in CONTEXT_KEYS}
+
+
+def is_debug_build(context):
+    build_type = context.get("dynamicxx_build_type")
+    return build_type is None or build_type.lower() in DEBUG_BUILD_TYPES
+
+
+def compare(baseline, current, threshold, noise_factor, gate):
+    """Returns (regressions, benchmarks without a baseline, report lines)."""
+    regressions = []
+    unrecorded = []
+    lines = []
+
+    width = max((len(name) for name in current), default=0)
+    for name in sorted(current):
+        now = current[name]
+        before = baseline.get(name)
+        if before is None:
+            lines.append("{:<{}}  NO BASELINE".format(name, width))
+            unrecorded.append(name)
+            continue
+
+        delta = now["median_ns"] - before["median_ns"]
+        relative = delta / before["median_ns"] if before["median_ns"] else 0.0
+        noise = noise_factor * MAD_TO_SIGMA * max(before["mad_ns"],
+                                                  now["mad_ns"])
+
+        verdict = "ok"
+        if relative > threshold and delta > noise:
+            if gate.search(name):
+                verdict = "REGRESSION"
+                regressions.append(name)
+            else:
+                verdict = "slower (not gated)"
+        elif relative < -threshold and -delta > noise:
+            verdict = "faster"
+
+        lines.append("{:<{}}  {:>12.1f} ns -> {:>12.1f} ns  {:>+7.1%}  {}".format(
+            name, width, before["median_ns"], now["median_ns"], relative,
+            verdict))
+
+    for name in sorted(set(baseline) - set(current)):
+        lines.append("{:<{}}  missing from this run".format(name, width))
+
+    return regressions, unrecorded, lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--benchmark", required=True,
+                        help="path to the benchmark executable")
+    parser.add_argument("--baseline", required=True,
+                        help="path to the baseline JSON file")
+    parser.add_argument("--output",
+                        help="where to keep the raw benchmark JSON results")
+    parser.add_argument("--results",
+                        help="compare existing raw results instead of running")
+    parser.add_argument("--repetitions", type=int, default=10)
+    parser.add_argument("--min-time", type=float, default=0.05,
+                        help="minimum seconds per repetition")
+    parser.add_argument("--filter", default="",
+                        help="only run benchmarks matching this regex")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"),
+                        default="cpu_time")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown tolerated (default: 10%%)")
+    parser.add_argument("--noise-factor", type=float, default=3.0,
+                        help="slowdown must exceed this many sigmas of noise")
+    parser.add_argument("--gate", default=".*",
+                        help="only regressions in benchmarks matching this "
+                        "regex fail the run")
+    parser.add_argument("--build-type",
+                        help="CMake build type of the benchmark executable, "
+                        "recorded in the results")
+    parser.add_argument("--update", action="store_true",
+                        help="record the results as the new baseline")
+    args = parser.parse_args()
+
+    if args.results:
+        with open(args.results, encoding="utf-8") as f:
+            results = json.load(f)
+    else:
+        output = args.output
+        if output is None:
+            output = tempfile.NamedTemporaryFile(suffix=".json",
+                                                 delete=False).name
+        results = run_benchmarks(args.benchmark, args.repetitions,
+                                 args.min_time, args.filter, args.build_type,
+                                 output)
+
+    current = summarise(results, args.metric)
+    if not current:
+        print("No benchmark results to compare", file=sys.stderr)
+        return 2
+
+    context = context_of(results)
+    if args.update:
+        if is_debug_build(context):
+            print("Refusing to record a baseline from a debug build; pass "
+                  "--build-type of an optimized build", file=sys.stderr)
+            return 2
+        baseline = {
+            "version": BASELINE_VERSION,
+            "metric": args.metric,
+            "context": context,
+            "benchmarks": current,
+        }
+        with open(args.baseline, "w", encoding="utf-8") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("Recorded {} benchmarks in {}".format(len(current),
+                                                    args.baseline))
+        return 0
+
+    with open(args.baseline, encoding="utf-8") as f:
+        baseline = json.load(f)
+    if baseline.get("version") != BASELINE_VERSION:
+        print("Unsupported baseline version", file=sys.stderr)
+        return 2
+    if baseline.get("metric") != args.metric:
+        print("Baseline was recorded with {}, not {}".format(
+            baseline.get("metric"), args.metric), file=sys.stderr)
+        return 2
+
+    recorded = baseline.get("context", {})
+    for key in ("num_cpus", "dynamicxx_build_type"):
+        if recorded.get(key) != context.get(key):
+            print("WARNING: baseline {} is {}, this run's is {}; timings may "
+                  "not be comparable".format(key, recorded.get(key),
+                                             context.get(key)),
+                  file=sys.stderr)
+
+    regressions, unrecorded, lines = compare(baseline["benchmarks"], current,
+                                             args.threshold,
+                                             args.noise_factor,
+                                             re.compile(args.gate))
+    print("\n".join(lines))
+
+    failed = False
+    if unrecorded:
+        print("\n{} benchmark(s) have no baseline; re-record it with "
+              "--update:".format(len(unrecorded)))
+        for name in unrecorded:
+            print("  " + name)
+        failed = True
+
+    if regressions:
+        print("\n{} benchmark(s) regressed beyond {:.0%} and {} sigma of "
+              "noise:".format(len(regressions), args.threshold,
+                              args.noise_factor))
+        for name in regressions:
+            print("  " + name)
+        failed = True
+
+    if failed:
+        return 1
+
+    print("\nNo regressions.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
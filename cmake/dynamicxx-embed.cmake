@@ -0,0 +1,56 @@
+# dynamicxx_embed_json(<target> <file> [NAME <name>] [NAMESPACE <namespace>])
+#
+# Compiles the JSON <file> into a static dynamicxx::Literal document and adds
+# it to <target>. The document is reached through the generated header
+# `<name>.h`, which declares `const dynamicxx::Literal& <name>();` in
+# <namespace>. <name> defaults to the file name without its extension.
+#
+# The generated header includes dynamicxx, so both its directory and dynamicxx
+# are public usage requirements of <target>: whatever links <target> can include
+# `<name>.h` too.
+
+# Cached, so that the function can find the script from any directory scope.
+set(_DYNAMICXX_EMBED_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/dynamicxx_embed_json.py"
+  CACHE INTERNAL "Generator used by dynamicxx_embed_json")
+
+function(dynamicxx_embed_json target file)
+  cmake_parse_arguments(PARSE_ARGV 2 ARG "" "NAME;NAMESPACE" "")
+  if (ARG_UNPARSED_ARGUMENTS)
+    message(FATAL_ERROR
+      "dynamicxx_embed_json: unexpected arguments ${ARG_UNPARSED_ARGUMENTS}")
+  endif ()
+
+  if (NOT Python3_EXECUTABLE)
+    find_package(Python3 COMPONENTS Interpreter REQUIRED)
+  endif ()
+
+  get_filename_component(input "${file}" ABSOLUTE)
+  if (ARG_NAME)
+    set(name "${ARG_NAME}")
+  else ()
+    get_filename_component(name "${file}" NAME_WE)
+    string(MAKE_C_IDENTIFIER "${name}" name)
+  endif ()
+
+  set(output_dir "${CMAKE_CURRENT_BINARY_DIR}/dynamicxx_embed/${target}")
+  set(outputs "${output_dir}/${name}.h" "${output_dir}/${name}.cc")
+  add_custom_command(
+    OUTPUT ${outputs}
+    COMMAND "${Python3_EXECUTABLE}" "${_DYNAMICXX_EMBED_SCRIPT}"
+      --input "${input}"
+      --output-dir "${output_dir}"
+      --name "${name}"
+      --namespace "${ARG_NAMESPACE}"
+    DEPENDS "${input}" "${_DYNAMICXX_EMBED_SCRIPT}"
+    COMMENT "Embedding ${file} as ${name}"
+    VERBATIM
+  )
+
+  target_sources(${target} PRIVATE ${outputs})
+  target_include_directories(${target} PUBLIC "${output_dir}")
+  if (TARGET dynamicxx::dynamicxx)
+    target_link_libraries(${target} PUBLIC dynamicxx::dynamicxx)
+  else ()
+    target_link_libraries(${target} PUBLIC dynamicxx)
+  endif ()
+endfunction()
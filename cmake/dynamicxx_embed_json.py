@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+"""Compiles a JSON file into a static dynamicxx::Literal document.
+
+Writes `<name>.h`, declaring `const dynamicxx::Literal& <name>();`, and
+`<name>.cc`, defining the document as constant-initialized static arrays. The
+program pays nothing at startup: there is no parsing and no allocation, and the
+data lives in read-only storage.
+
+Object keys are emitted in ascending byte order, so lookups are binary
+searches; JSON gives member order no meaning. Duplicate keys are an error.
+
+Usage:
+    dynamicxx_embed_json.py --input config.json --output-dir gen \\
+                            --name DefaultConfig [--namespace app::embedded]
+"""
+
+import argparse
+import json
+import math
+import pathlib
+import re
+import sys
+
+INT64_MIN = -(1 << 63)
+INT64_MAX = (1 << 63) - 1
+
+
+class EmbedError(Exception):
+    pass
+
+
+def reject_duplicates(pairs):
+    keys = set()
+    for key, _ in pairs:
+        if key in keys:
+            raise EmbedError("duplicate key {!r}".format(key))
+        keys.add(key)
+    return pairs
+
+
+def reject_constant(name):
+    raise EmbedError("{} is not valid JSON".format(name))
+
+
+def string_literal(text):
+    """A C++ string literal with the UTF-8 bytes of `text`.
+
+    Octal escapes are used because, unlike hexadecimal ones, they end after
+    three digits and cannot swallow the character that follows.
+    """
+    out = ['"']
+    for byte in text.encode("utf-8"):
+        char = chr(byte)
+        if char in ('"', "\\"):
+            out.append("\\" + char)
+        elif 0x20 <= byte < 0x7F and char != "?":
+            out.append(char)
+        else:
+            out.append("\\{:03o}".format(byte))
+    out.append('"')
+    return "".join(out)
+
+
+def number_literal(value):
+    if isinstance(value, bool):
+        return "true" if value else "false"
+    if isinstance(value, int):
+        if INT64_MIN <= value <= INT64_MAX:
+            if value == INT64_MIN:
+                return "(-INT64_C(9223372036854775807) - 1)"
+            return "INT64_C({})".format(value)
+        value = float(value)
+    if not math.isfinite(value):
+        raise EmbedError("{} cannot be represented".format(value))
+    return repr(float(value))
+
+
+class Generator:
+    def __init__(self):
+        self.definitions = []
+        self.count = 0
+
+    def next_name(self):
+        name = "kNode{}".format(self.count)
+        self.count += 1
+        return name
+
+    def value(self, value):
+        """Returns an expression for `value`, defining its children first."""
+        if value is None:
+            return "::dynamicxx::Literal(nullptr)"
+        if isinstance(value, (bool, int, float)):
+            return "::dynamicxx::Literal({})".format(number_literal(value))
+        if isinstance(value, str):
+            return "::dynamicxx::Literal({})".format(string_literal(value))
+        if isinstance(value, Pairs):
+            return self.object(value)
+        if isinstance(value, list):
+            if not value:
+                return "::dynamicxx::Literal::ArrayOf(nullptr, 0)"
+            items = [self.value(item) for item in value]
+            name = self.next_name()
+            self.define("::dynamicxx::Literal", name, items)
+            return "::dynamicxx::Literal::ArrayOf({}, {})".format(
+                name, len(items))
+        raise EmbedError("unexpected value {!r}".format(value))
+
+    def object(self, pairs):
+        if not pairs:
+            return "::dynamicxx::Literal::SortedObjectOf(nullptr, 0)"
+        pairs = sorted(pairs, key=lambda pair: pair[0].encode("utf-8"))
+        members = [
+            "::dynamicxx::LiteralMember({}, {})".format(
+                string_literal(key), self.value(item))
+            for key, item in pairs
+        ]
+        name = self.next_name()
+        self.define("::dynamicxx::LiteralMember", name, members)
+        return "::dynamicxx::Literal::SortedObjectOf({}, {})".format(
+            name, len(members))
+
+    def define(self, type_name, name, elements):
+        lines = ["constexpr {} {}[] = {{".format(type_name, name)]
+        lines.extend("    {},".format(element) for element in elements)
+        lines.append("};")
+        self.definitions.append("\n".join(lines))
+
+
+class Pairs(list):
+    """Marks a decoded JSON object, as opposed to an array."""
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        return json.load(f,
+                         object_pairs_hook=lambda pairs: Pairs(
+                             reject_duplicates(pairs)),
+                         parse_constant=reject_constant)
+
+
+def open_namespace(namespace):
+    return "".join("namespace {} {{\n".format(part)
+                   for part in namespace.split("::") if part)
+
+
+def close_namespace(namespace):
+    return "".join("}}  // namespace {}\n".format(part)
+                   for part in reversed(namespace.split("::")) if part)
+
+
+def generate(document, name, namespace, source):
+    generator = Generator()
+    root = generator.value(document)
+
+    guard = re.sub(r"[^A-Za-z0-9]", "_",
+                   "{}_{}_H".format(namespace, name)).upper().strip("_")
+    header = (
+        "// Generated by dynamicxx_embed_json from {source}. Do not edit.\n"
+        "\n"
+        "#ifndef {guard}\n"
+        "#define {guard}\n"
+        "\n"
+        "#include <dynamicxx/literal.h>\n"
+        "\n"
+        "{open}"
+        "const ::dynamicxx::Literal& {name}();\n"
+        "{close}"
+        "\n"
+        "#endif  // {guard}\n").format(source=source, guard=guard,
+                                       open=open_namespace(namespace),
+                                       close=close_namespace(namespace),
+                                       name=name)
+
+    body = (
+        "// Generated by dynamicxx_embed_json from {source}. Do not edit.\n"
+        "\n"
+        "#include \"{name}.h\"\n"
+        "\n"
+        "#include <cstdint>\n"
+        "\n"
+        "{open}"
+        "namespace {{\n"
+        "\n"
+        "{definitions}"
+        "constexpr ::dynamicxx::Literal kRoot = {root};\n"
+        "\n"
+        "}}  // namespace\n"
+        "\n"
+        "const ::dynamicxx::Literal& {name}() {{ return kRoot; }}\n"
+        "{close}").format(source=source, name=name,
+                          open=open_namespace(namespace),
+                          close=close_namespace(namespace),
+                          definitions="".join(
+                              definition + "\n\n"
+                              for definition in generator.definitions),
+                          root=root)
+    return header, body
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--input", required=True, help="the JSON file")
+    parser.add_argument("--output-dir", required=True)
+    parser.add_argument("--name", required=True,
+                        help="name of the generated accessor function")
+    parser.add_argument("--namespace", default="",
+                        help="namespace of the accessor, such as a::b")
+    args = parser.parse_args()
+
+    if not re.fullmatch(r"[A-Za-z_][A-Za-z0-9_]*", args.name):
+        parser.error("--name must be a C++ identifier")
+    if args.namespace and not re.fullmatch(
+            r"[A-Za-z_][A-Za-z0-9_]*(::[A-Za-z_][A-Za-z0-9_]*)*",
+            args.namespace):
+        parser.error("--namespace must be a C++ namespace name")
+
+    try:
+        document = load(args.input)
+        header, body = generate(document, args.name, args.namespace,
+                                pathlib.Path(args.input).name)
+    except (EmbedError, OverflowError, ValueError) as error:
+        print("{}: {}".format(args.input, error), file=sys.stderr)
+        return 1
+
+    output_dir = pathlib.Path(args.output_dir)
+    output_dir.mkdir(parents=True, exist_ok=True)
+    (output_dir / "{}.h".format(args.name)).write_text(header,
+                                                       encoding="utf-8")
+    (output_dir / "{}.cc".format(args.name)).write_text(body,
+                                                        encoding="utf-8")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
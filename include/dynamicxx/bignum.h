@@ -0,0 +1,792 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Exact numbers: an arbitrary precision BigInteger and a Decimal.
+//
+// They can replace the IntegerType and NumberType of a BasicDynamic, as
+// DynamicExact does, for documents carrying identifiers longer than 64 bits or
+// amounts that must not be rounded. A BigInteger that fits in 64 bits is stored
+// inline and uses plain machine arithmetic; only larger values allocate. A
+// Decimal is a BigInteger coefficient scaled by a power of ten, so it is exact
+// for any decimal text and keeps the scale it was written with: "1.50" prints
+// as "1.50", though it equals "1.5".
+
+#ifndef DYNAMICXX_BIGNUM_H
+#define DYNAMICXX_BIGNUM_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dynamicxx/dynamicxx.h"
+#include "dynamicxx/numeric.h"
+
+namespace dynamicxx {
+namespace detail {
+namespace bignum {
+
+using Limb = std::uint32_t;
+// Little-endian base 2^32 digits, without leading zeros.
+using Magnitude = std::vector<Limb>;
+
+constexpr std::int64_t Int64Max = std::numeric_limits<std::int64_t>::max();
+constexpr std::int64_t Int64Min = std::numeric_limits<std::int64_t>::min();
+
+inline bool AddOverflows(const std::int64_t a, const std::int64_t b,
+                         std::int64_t& result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_add_overflow(a, b, &result);
+#else
+    if ((b > 0 && a > Int64Max - b) || (b < 0 && a < Int64Min - b)) {
+        return true;
+    }
+    result = a + b;
+    return false;
+#endif
+}
+
+inline bool SubtractOverflows(const std::int64_t a, const std::int64_t b,
+                              std::int64_t& result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_sub_overflow(a, b, &result);
+#else
+    if ((b < 0 && a > Int64Max + b) || (b > 0 && a < Int64Min + b)) {
+        return true;
+    }
+    result = a - b;
+    return false;
+#endif
+}
+
+inline bool MultiplyOverflows(const std::int64_t a, const std::int64_t b,
+                              std::int64_t& result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_mul_overflow(a, b, &result);
+#else
+    if (a == 0 || b == 0) {
+        result = 0;
+        return false;
+    }
+    if (a > 0 ? (b > 0 ? a > Int64Max / b : b < Int64Min / a)
+              : (b > 0 ? a < Int64Min / b : a < Int64Max / b)) {
+        return true;
+    }
+    result = a * b;
+    return false;
+#endif
+}
+
+inline void Trim(Magnitude& magnitude) {
+    while (!magnitude.empty() && magnitude.back() == 0) {
+        magnitude.pop_back();
+    }
+}
+
+inline Magnitude MagnitudeOf(std::uint64_t value) {
+    Magnitude magnitude;
+    while (value != 0) {
+        magnitude.push_back(static_cast<Limb>(value));
+        value >>= 32;
+    }
+    return magnitude;
+}
+
+inline int Compare(const Magnitude& lhs, const Magnitude& rhs) noexcept {
+    if (lhs.size() != rhs.size()) {
+        return lhs.size() < rhs.size() ? -1 : 1;
+    }
+    for (std::size_t i = lhs.size(); i-- > 0;) {
+        if (lhs[i] != rhs[i]) {
+            return lhs[i] < rhs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+inline Magnitude Add(const Magnitude& lhs, const Magnitude& rhs) {
+    const Magnitude& longer = lhs.size() >= rhs.size() ? lhs : rhs;
+    const Magnitude& shorter = lhs.size() >= rhs.size() ? rhs : lhs;
+    Magnitude sum(longer.size() + 1);
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < longer.size(); ++i) {
+        carry += longer[i];
+        if (i < shorter.size()) {
+            carry += shorter[i];
+        }
+        sum[i] = static_cast<Limb>(carry);
+        carry >>= 32;
+    }
+    sum.back() = static_cast<Limb>(carry);
+    Trim(sum);
+    return sum;
+}
+
+// Requires lhs >= rhs.
+inline Magnitude Subtract(const Magnitude& lhs, const Magnitude& rhs) {
+    Magnitude difference(lhs.size());
+    std::uint64_t borrow = 0;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        const std::uint64_t subtrahend =
+            (i < rhs.size() ? rhs[i] : 0) + borrow;
+        borrow = lhs[i] < subtrahend ? 1 : 0;
+        difference[i] = static_cast<Limb>((borrow << 32) + lhs[i] - subtrahend);
+    }
+    Trim(difference);
+    return difference;
+}
+
+inline Magnitude Multiply(const Magnitude& lhs, const Magnitude& rhs) {
+    if (lhs.empty() || rhs.empty()) {
+        return Magnitude();
+    }
+    Magnitude product(lhs.size() + rhs.size());
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        std::uint64_t carry = 0;
+        for (std::size_t j = 0; j < rhs.size(); ++j) {
+            carry += static_cast<std::uint64_t>(lhs[i]) * rhs[j] +
+                     product[i + j];
+            product[i + j] = static_cast<Limb>(carry);
+            carry >>= 32;
+        }
+        product[i + rhs.size()] = static_cast<Limb>(carry);
+    }
+    Trim(product);
+    return product;
+}
+
+// magnitude = magnitude * factor + addend.
+inline void MultiplyAdd(Magnitude& magnitude, const Limb factor,
+                        const Limb addend) {
+    std::uint64_t carry = addend;
+    for (auto& limb : magnitude) {
+        carry += static_cast<std::uint64_t>(limb) * factor;
+        limb = static_cast<Limb>(carry);
+        carry >>= 32;
+    }
+    if (carry != 0) {
+        magnitude.push_back(static_cast<Limb>(carry));
+    }
+}
+
+// magnitude /= divisor; returns the remainder.
+inline Limb DivideSmall(Magnitude& magnitude, const Limb divisor) {
+    std::uint64_t remainder = 0;
+    for (std::size_t i = magnitude.size(); i-- > 0;) {
+        const auto current = (remainder << 32) | magnitude[i];
+        magnitude[i] = static_cast<Limb>(current / divisor);
+        remainder = current % divisor;
+    }
+    Trim(magnitude);
+    return static_cast<Limb>(remainder);
+}
+
+// Correctly rounded; infinite if out of range.
+inline double ParseDouble(const std::string& text) {
+    const auto infinity = std::numeric_limits<double>::infinity();
+    double value = text[0] == '-' ? -infinity : infinity;
+    (void)ParseNumber(text.data(), text.data() + text.size(), value);
+    return value;
+}
+
+}  // namespace bignum
+}  // namespace detail
+
+class BigInteger {
+    using Limb = detail::bignum::Limb;
+    using Magnitude = detail::bignum::Magnitude;
+
+   public:
+    BigInteger() noexcept = default;
+
+    template <class Int,
+              typename std::enable_if<std::is_integral<Int>::value &&
+                                          !detail::IsBool<Int>::value,
+                                      int>::type = 0>
+    BigInteger(const Int value) {
+        if (std::is_signed<Int>::value ||
+            static_cast<std::uint64_t>(value) <=
+                static_cast<std::uint64_t>(detail::bignum::Int64Max)) {
+            small_ = static_cast<std::int64_t>(value);
+        } else {
+            *this = FromMagnitude(
+                false,
+                detail::bignum::MagnitudeOf(static_cast<std::uint64_t>(value)));
+        }
+    }
+
+    BigInteger(const BigInteger& that)
+        : small_(that.small_), size_(that.size_), negative_(that.negative_) {
+        if (that.limbs_) {
+            limbs_.reset(new Limb[size_]);
+            std::copy(that.limbs_.get(), that.limbs_.get() + size_,
+                      limbs_.get());
+        }
+    }
+    BigInteger(BigInteger&& that) noexcept
+        : small_(that.small_),
+          limbs_(std::move(that.limbs_)),
+          size_(that.size_),
+          negative_(that.negative_) {
+        that.small_ = 0;
+        that.size_ = 0;
+    }
+    BigInteger& operator=(BigInteger that) noexcept {
+        std::swap(small_, that.small_);
+        std::swap(limbs_, that.limbs_);
+        std::swap(size_, that.size_);
+        std::swap(negative_, that.negative_);
+        return *this;
+    }
+
+    // Parses an optionally signed run of decimal digits. Throws
+    // std::invalid_argument if the text is anything else.
+    DNODISCARD static BigInteger Parse(const char* text,
+                                       const std::size_t size) {
+        std::size_t i = 0;
+        bool negative = false;
+        if (i < size && (text[i] == '-' || text[i] == '+')) {
+            negative = text[i] == '-';
+            ++i;
+        }
+        if (i == size) {
+            throw std::invalid_argument("BigInteger::Parse expects digits");
+        }
+        for (std::size_t j = i; j < size; ++j) {
+            if (text[j] < '0' || text[j] > '9') {
+                throw std::invalid_argument(
+                    "BigInteger::Parse expects only digits");
+            }
+        }
+        // Up to 18 digits always fit in 64 bits.
+        if (size - i <= 18) {
+            std::int64_t value = 0;
+            for (; i < size; ++i) {
+                value = value * 10 + (text[i] - '0');
+            }
+            return BigInteger(negative ? -value : value);
+        }
+        Magnitude magnitude;
+        while (i < size) {
+            const auto count = std::min<std::size_t>(9, size - i);
+            Limb factor = 1;
+            Limb chunk = 0;
+            for (std::size_t end = i + count; i < end; ++i) {
+                factor *= 10;
+                chunk = chunk * 10 + static_cast<Limb>(text[i] - '0');
+            }
+            detail::bignum::MultiplyAdd(magnitude, factor, chunk);
+        }
+        return FromMagnitude(negative, std::move(magnitude));
+    }
+    DNODISCARD static BigInteger Parse(const std::string& text) {
+        return Parse(text.data(), text.size());
+    }
+
+    // Whether the value is held inline, which is exactly when it fits in an
+    // std::int64_t.
+    DNODISCARD bool FitsInt64() const noexcept { return !limbs_; }
+
+    // Bytes of the limbs spilled to the heap, for BasicDynamic::MemoryUsage().
+    DNODISCARD std::size_t HeapBytes() const noexcept {
+        return limbs_ ? size_ * sizeof(Limb) : 0;
+    }
+
+    // Throws std::overflow_error unless FitsInt64().
+    DNODISCARD std::int64_t ToInt64() const {
+        if (!FitsInt64()) {
+            throw std::overflow_error("BigInteger does not fit in 64 bits");
+        }
+        return small_;
+    }
+
+    // Correctly rounded.
+    DNODISCARD double ToDouble() const {
+        if (FitsInt64()) {
+            return static_cast<double>(small_);
+        }
+        return detail::bignum::ParseDouble(ToString());
+    }
+
+    DNODISCARD std::string ToString() const {
+        char buffer[detail::MaxIntegerLength];
+        if (FitsInt64()) {
+            const char* end = detail::FormatInteger(buffer, small_);
+            return std::string(buffer, static_cast<std::size_t>(end - buffer));
+        }
+        auto magnitude = MagnitudeOfThis();
+        std::vector<Limb> groups;
+        while (!magnitude.empty()) {
+            groups.push_back(
+                detail::bignum::DivideSmall(magnitude, 1000000000));
+        }
+        std::string text = negative_ ? "-" : "";
+        text.reserve(1 + 9 * groups.size());
+        auto length = static_cast<std::size_t>(
+            detail::FormatInteger(buffer, groups.back()) - buffer);
+        text.append(buffer, length);
+        for (std::size_t i = groups.size() - 1; i-- > 0;) {
+            length = static_cast<std::size_t>(
+                detail::FormatInteger(buffer, groups[i]) - buffer);
+            text.append(9 - length, '0');
+            text.append(buffer, length);
+        }
+        return text;
+    }
+
+    // -1, 0 or 1.
+    DNODISCARD int Sign() const noexcept {
+        if (FitsInt64()) {
+            return (small_ > 0) - (small_ < 0);
+        }
+        return negative_ ? -1 : 1;
+    }
+
+    DNODISCARD friend BigInteger operator+(const BigInteger& lhs,
+                                           const BigInteger& rhs) {
+        std::int64_t sum;
+        if (lhs.FitsInt64() && rhs.FitsInt64() &&
+            !detail::bignum::AddOverflows(lhs.small_, rhs.small_, sum)) {
+            LIKELY { return BigInteger(sum); }
+        }
+        return AddSigned(lhs.IsNegative(), lhs.MagnitudeOfThis(),
+                         rhs.IsNegative(), rhs.MagnitudeOfThis());
+    }
+    DNODISCARD friend BigInteger operator-(const BigInteger& lhs,
+                                           const BigInteger& rhs) {
+        std::int64_t difference;
+        if (lhs.FitsInt64() && rhs.FitsInt64() &&
+            !detail::bignum::SubtractOverflows(lhs.small_, rhs.small_,
+                                               difference)) {
+            LIKELY { return BigInteger(difference); }
+        }
+        return AddSigned(lhs.IsNegative(), lhs.MagnitudeOfThis(),
+                         rhs.Sign() > 0, rhs.MagnitudeOfThis());
+    }
+    DNODISCARD friend BigInteger operator*(const BigInteger& lhs,
+                                           const BigInteger& rhs) {
+        std::int64_t product;
+        if (lhs.FitsInt64() && rhs.FitsInt64() &&
+            !detail::bignum::MultiplyOverflows(lhs.small_, rhs.small_,
+                                               product)) {
+            LIKELY { return BigInteger(product); }
+        }
+        return FromMagnitude(
+            lhs.IsNegative() != rhs.IsNegative(),
+            detail::bignum::Multiply(lhs.MagnitudeOfThis(),
+                                     rhs.MagnitudeOfThis()));
+    }
+    DNODISCARD BigInteger operator-() const {
+        if (FitsInt64() && small_ != detail::bignum::Int64Min) {
+            return BigInteger(-small_);
+        }
+        return FromMagnitude(Sign() > 0, MagnitudeOfThis());
+    }
+
+    BigInteger& operator+=(const BigInteger& that) {
+        return *this = *this + that;
+    }
+    BigInteger& operator-=(const BigInteger& that) {
+        return *this = *this - that;
+    }
+    BigInteger& operator*=(const BigInteger& that) {
+        return *this = *this * that;
+    }
+
+    // -1, 0 or 1 as this is less than, equal to or greater than `that`.
+    DNODISCARD int Compare(const BigInteger& that) const {
+        if (FitsInt64() && that.FitsInt64()) {
+            return (small_ > that.small_) - (small_ < that.small_);
+        }
+        if (IsNegative() != that.IsNegative()) {
+            return IsNegative() ? -1 : 1;
+        }
+        const auto order = detail::bignum::Compare(MagnitudeOfThis(),
+                                                   that.MagnitudeOfThis());
+        return IsNegative() ? -order : order;
+    }
+
+    DNODISCARD friend bool operator==(const BigInteger& lhs,
+                                      const BigInteger& rhs) noexcept {
+        if (lhs.FitsInt64() || rhs.FitsInt64()) {
+            return lhs.FitsInt64() && rhs.FitsInt64() &&
+                   lhs.small_ == rhs.small_;
+        }
+        return lhs.negative_ == rhs.negative_ && lhs.size_ == rhs.size_ &&
+               std::equal(lhs.limbs_.get(), lhs.limbs_.get() + lhs.size_,
+                          rhs.limbs_.get());
+    }
+    DNODISCARD friend bool operator!=(const BigInteger& lhs,
+                                      const BigInteger& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+    DNODISCARD friend bool operator<(const BigInteger& lhs,
+                                     const BigInteger& rhs) {
+        return lhs.Compare(rhs) < 0;
+    }
+    DNODISCARD friend bool operator>(const BigInteger& lhs,
+                                     const BigInteger& rhs) {
+        return rhs < lhs;
+    }
+    DNODISCARD friend bool operator<=(const BigInteger& lhs,
+                                      const BigInteger& rhs) {
+        return !(rhs < lhs);
+    }
+    DNODISCARD friend bool operator>=(const BigInteger& lhs,
+                                      const BigInteger& rhs) {
+        return !(lhs < rhs);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream,
+                                    const BigInteger& value) {
+        return stream << value.ToString();
+    }
+
+   private:
+    DNODISCARD bool IsNegative() const noexcept { return Sign() < 0; }
+
+    DNODISCARD Magnitude MagnitudeOfThis() const {
+        if (FitsInt64()) {
+            return detail::bignum::MagnitudeOf(
+                small_ < 0 ? 0 - static_cast<std::uint64_t>(small_)
+                           : static_cast<std::uint64_t>(small_));
+        }
+        return Magnitude(limbs_.get(), limbs_.get() + size_);
+    }
+
+    // Keeps every value that fits in 64 bits inline, so that equal values
+    // always have the same representation.
+    static BigInteger FromMagnitude(const bool negative, Magnitude magnitude) {
+        detail::bignum::Trim(magnitude);
+        if (magnitude.size() <= 2) {
+            std::uint64_t value = magnitude.empty() ? 0 : magnitude[0];
+            if (magnitude.size() == 2) {
+                value |= static_cast<std::uint64_t>(magnitude[1]) << 32;
+            }
+            const auto max =
+                static_cast<std::uint64_t>(detail::bignum::Int64Max);
+            if (value <= max) {
+                const auto small = static_cast<std::int64_t>(value);
+                return BigInteger(negative ? -small : small);
+            }
+            if (negative && value == max + 1) {
+                return BigInteger(detail::bignum::Int64Min);
+            }
+        }
+        BigInteger result;
+        result.negative_ = negative;
+        result.size_ = static_cast<std::uint32_t>(magnitude.size());
+        result.limbs_.reset(new Limb[magnitude.size()]);
+        std::copy(magnitude.begin(), magnitude.end(), result.limbs_.get());
+        return result;
+    }
+
+    static BigInteger AddSigned(const bool lhs_negative, const Magnitude& lhs,
+                                const bool rhs_negative,
+                                const Magnitude& rhs) {
+        if (lhs_negative == rhs_negative) {
+            return FromMagnitude(lhs_negative, detail::bignum::Add(lhs, rhs));
+        }
+        const auto order = detail::bignum::Compare(lhs, rhs);
+        if (order == 0) {
+            return BigInteger();
+        }
+        if (order > 0) {
+            return FromMagnitude(lhs_negative,
+                                 detail::bignum::Subtract(lhs, rhs));
+        }
+        return FromMagnitude(rhs_negative, detail::bignum::Subtract(rhs, lhs));
+    }
+
+    // The value while it fits in 64 bits; otherwise the magnitude is in
+    // limbs_ and the sign in negative_.
+    std::int64_t small_ = 0;
+    std::unique_ptr<Limb[]> limbs_;
+    std::uint32_t size_ = 0;
+    bool negative_ = false;
+};
+
+// coefficient * 10^exponent.
+class Decimal {
+   public:
+    // The exponent range of IEEE 754 decimal128. Results outside it throw
+    // std::out_of_range.
+    static constexpr std::int32_t MaxExponent = 6144;
+    static constexpr std::int32_t MinExponent = -6176;
+
+    Decimal() = default;
+
+    template <class Int,
+              typename std::enable_if<std::is_integral<Int>::value &&
+                                          !detail::IsBool<Int>::value,
+                                      int>::type = 0>
+    Decimal(const Int value) : coefficient_(value) {}
+
+    Decimal(BigInteger coefficient, const std::int32_t exponent)
+        : coefficient_(std::move(coefficient)), exponent_(exponent) {
+        CheckExponent(exponent_);
+    }
+
+    // The shortest decimal that converts back to the same double, so 0.1
+    // becomes exactly 0.1. Throws std::invalid_argument for infinities and
+    // NaN.
+    template <class Float,
+              typename std::enable_if<std::is_floating_point<Float>::value,
+                                      int>::type = 0>
+    Decimal(const Float value)
+        : Decimal(FromDouble(static_cast<double>(value))) {}
+
+    // Parses decimal text such as "-12.50" or "1.5e-3". Throws
+    // std::invalid_argument if the text is anything else.
+    DNODISCARD static Decimal Parse(const char* text, const std::size_t size) {
+        std::string digits;
+        digits.reserve(size);
+        std::size_t i = 0;
+        if (i < size && (text[i] == '-' || text[i] == '+')) {
+            digits += text[i++];
+        }
+        std::int64_t exponent = 0;
+        bool any_digits = false;
+        for (; i < size && text[i] >= '0' && text[i] <= '9'; ++i) {
+            digits += text[i];
+            any_digits = true;
+        }
+        if (i < size && text[i] == '.') {
+            for (++i; i < size && text[i] >= '0' && text[i] <= '9'; ++i) {
+                digits += text[i];
+                --exponent;
+                any_digits = true;
+            }
+        }
+        if (!any_digits) {
+            throw std::invalid_argument("Decimal::Parse expects digits");
+        }
+        if (i < size && (text[i] == 'e' || text[i] == 'E')) {
+            ++i;
+            bool negative = false;
+            if (i < size && (text[i] == '-' || text[i] == '+')) {
+                negative = text[i++] == '-';
+            }
+            if (i == size) {
+                throw std::invalid_argument(
+                    "Decimal::Parse expects exponent digits");
+            }
+            std::int64_t written = 0;
+            for (; i < size && text[i] >= '0' && text[i] <= '9'; ++i) {
+                written = std::min<std::int64_t>(written * 10 + (text[i] - '0'),
+                                                 1000000000);
+            }
+            exponent += negative ? -written : written;
+        }
+        if (i != size) {
+            throw std::invalid_argument("Decimal::Parse found trailing text");
+        }
+        CheckExponent(exponent);
+        return Decimal(BigInteger::Parse(digits),
+                       static_cast<std::int32_t>(exponent));
+    }
+    DNODISCARD static Decimal Parse(const std::string& text) {
+        return Parse(text.data(), text.size());
+    }
+
+    DNODISCARD const BigInteger& Coefficient() const noexcept {
+        return coefficient_;
+    }
+    DNODISCARD std::int32_t Exponent() const noexcept { return exponent_; }
+
+    DNODISCARD std::size_t HeapBytes() const noexcept {
+        return coefficient_.HeapBytes();
+    }
+
+    // Positional notation, with as many fractional digits as the scale.
+    DNODISCARD std::string ToString() const {
+        std::string digits = coefficient_.ToString();
+        std::string sign;
+        if (digits[0] == '-') {
+            sign = "-";
+            digits.erase(0, 1);
+        }
+        if (exponent_ >= 0) {
+            if (coefficient_.Sign() != 0) {
+                digits.append(static_cast<std::size_t>(exponent_), '0');
+            }
+            return sign + digits;
+        }
+        const auto fraction = static_cast<std::size_t>(-exponent_);
+        if (digits.size() <= fraction) {
+            digits.insert(0, fraction - digits.size() + 1, '0');
+        }
+        digits.insert(digits.size() - fraction, 1, '.');
+        return sign + digits;
+    }
+
+    // Correctly rounded.
+    DNODISCARD double ToDouble() const {
+        if (exponent_ == 0 && coefficient_.FitsInt64()) {
+            return static_cast<double>(coefficient_.ToInt64());
+        }
+        return detail::bignum::ParseDouble(coefficient_.ToString() + "e" +
+                                           std::to_string(exponent_));
+    }
+
+    DNODISCARD int Sign() const noexcept { return coefficient_.Sign(); }
+
+    DNODISCARD friend Decimal operator+(const Decimal& lhs,
+                                        const Decimal& rhs) {
+        if (lhs.exponent_ == rhs.exponent_) {
+            return Decimal(lhs.coefficient_ + rhs.coefficient_, lhs.exponent_);
+        }
+        const auto exponent = std::min(lhs.exponent_, rhs.exponent_);
+        return Decimal(lhs.ScaledTo(exponent) + rhs.ScaledTo(exponent),
+                       exponent);
+    }
+    DNODISCARD friend Decimal operator-(const Decimal& lhs,
+                                        const Decimal& rhs) {
+        return lhs + (-rhs);
+    }
+    DNODISCARD friend Decimal operator*(const Decimal& lhs,
+                                        const Decimal& rhs) {
+        const auto exponent =
+            static_cast<std::int64_t>(lhs.exponent_) + rhs.exponent_;
+        CheckExponent(exponent);
+        return Decimal(lhs.coefficient_ * rhs.coefficient_,
+                       static_cast<std::int32_t>(exponent));
+    }
+    DNODISCARD Decimal operator-() const {
+        return Decimal(-coefficient_, exponent_);
+    }
+
+    Decimal& operator+=(const Decimal& that) { return *this = *this + that; }
+    Decimal& operator-=(const Decimal& that) { return *this = *this - that; }
+    Decimal& operator*=(const Decimal& that) { return *this = *this * that; }
+
+    // Compares values, not representations: 1.50 equals 1.5.
+    DNODISCARD int Compare(const Decimal& that) const {
+        if (exponent_ == that.exponent_) {
+            return coefficient_.Compare(that.coefficient_);
+        }
+        if (Sign() != that.Sign()) {
+            return Sign() < that.Sign() ? -1 : 1;
+        }
+        const auto exponent = std::min(exponent_, that.exponent_);
+        return ScaledTo(exponent).Compare(that.ScaledTo(exponent));
+    }
+
+    DNODISCARD friend bool operator==(const Decimal& lhs, const Decimal& rhs) {
+        return lhs.Compare(rhs) == 0;
+    }
+    DNODISCARD friend bool operator!=(const Decimal& lhs, const Decimal& rhs) {
+        return !(lhs == rhs);
+    }
+    DNODISCARD friend bool operator<(const Decimal& lhs, const Decimal& rhs) {
+        return lhs.Compare(rhs) < 0;
+    }
+    DNODISCARD friend bool operator>(const Decimal& lhs, const Decimal& rhs) {
+        return rhs < lhs;
+    }
+    DNODISCARD friend bool operator<=(const Decimal& lhs, const Decimal& rhs) {
+        return !(rhs < lhs);
+    }
+    DNODISCARD friend bool operator>=(const Decimal& lhs, const Decimal& rhs) {
+        return !(lhs < rhs);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream,
+                                    const Decimal& value) {
+        return stream << value.ToString();
+    }
+
+   private:
+    static void CheckExponent(const std::int64_t exponent) {
+        if (exponent < MinExponent || exponent > MaxExponent) {
+            throw std::out_of_range("Decimal exponent out of range");
+        }
+    }
+
+    // The coefficient for the same value at a smaller exponent.
+    DNODISCARD BigInteger ScaledTo(const std::int32_t exponent) const {
+        auto digits = static_cast<std::uint32_t>(exponent_ - exponent);
+        BigInteger scaled = coefficient_;
+        for (; digits >= 18; digits -= 18) {
+            scaled *= BigInteger(INT64_C(1000000000000000000));
+        }
+        std::int64_t factor = 1;
+        while (digits-- > 0) {
+            factor *= 10;
+        }
+        return scaled * BigInteger(factor);
+    }
+
+    static Decimal FromDouble(const double value) {
+        if (!std::isfinite(value)) {
+            throw std::invalid_argument("Decimal cannot hold inf or NaN");
+        }
+        if (value == 0) {
+            return Decimal();
+        }
+        char text[40];
+        for (int precision = 1; precision <= 17; ++precision) {
+            std::snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+            if (std::strtod(text, nullptr) == value) {
+                break;
+            }
+        }
+        // "-d.ddde+xx", with the locale's decimal point.
+        std::string digits;
+        const char* c = text;
+        for (; *c != 'e'; ++c) {
+            if ((*c >= '0' && *c <= '9') || *c == '-') {
+                digits += *c;
+            }
+        }
+        const auto exponent =
+            static_cast<std::int32_t>(std::strtol(c + 1, nullptr, 10));
+        const auto fraction = static_cast<std::int32_t>(
+            digits.size() - (digits[0] == '-' ? 2 : 1));
+        return Decimal(BigInteger::Parse(digits), exponent - fraction);
+    }
+
+    BigInteger coefficient_;
+    std::int32_t exponent_ = 0;
+};
+
+constexpr std::int32_t Decimal::MaxExponent;
+constexpr std::int32_t Decimal::MinExponent;
+
+template <>
+struct IsIntegerPolicy<BigInteger> : std::true_type {};
+template <>
+struct IsNumberPolicy<Decimal> : std::true_type {};
+
+// Dynamic, with arbitrary precision integers and exact decimal numbers.
+using DynamicExact =
+    BasicDynamic<BigInteger, Decimal, DefaultString, DefaultBlobContainer,
+                 DefaultArrayContainer, DefaultObjectContainer,
+                 DefaultToString, DefaultToIndex, detail::Just>;
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_BIGNUM_H
@@ -0,0 +1,610 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A compact, self-describing binary encoding of documents.
+//
+// Every value is a one-byte tag followed by its payload:
+//
+//   Null, False, True, Undefined   nothing
+//   Integer                        zigzag varint
+//   Number                         8 bytes, IEEE 754, little endian
+//   String, Blob                   varint length, then the bytes
+//   Array                          varint count, then the elements
+//   Object                         varint count, then per member a varint
+//                                  key length, the key and the value
+//
+// Varints are LEB128: seven bits per byte, least significant first, with the
+// high bit set on all but the last byte. String and blob views are encoded as
+// the strings and blobs they refer to. The encoding does not depend on the
+// host's byte order, so documents can be exchanged between machines.
+//
+// With StringEncoding::Dictionary, each string of at most 64 bytes that occurs
+// more than once is written once, in a table at the start of the document, and
+// each occurrence as a reference to it:
+//
+//   Dictionary                     varint count, then per string a varint
+//                                  length and the bytes; only first
+//   StringRef                      varint position in the table
+//
+// The most frequent strings come first, so their references take one byte.
+// A reference takes at least two bytes, so the strings they expand to add up
+// to at most 32 times the size of the document; the decoder rejects documents
+// whose references expand to more.
+
+#ifndef DYNAMICXX_BINARY_H
+#define DYNAMICXX_BINARY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dynamicxx/dictionary.h"
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+
+// Thrown when decoding bytes that are not a valid encoding.
+class InvalidBinaryException : public std::runtime_error {
+   public:
+    InvalidBinaryException(const char* what, const std::size_t offset)
+        : std::runtime_error(what), offset_(offset) {}
+
+    std::size_t Offset() const noexcept { return offset_; }
+
+   private:
+    std::size_t offset_;
+};
+
+// Thrown when encoding a document nested more deeply than DecodeBinary()
+// accepts, which could never be read back.
+class BinaryDepthException : public std::runtime_error {
+   public:
+    BinaryDepthException()
+        : std::runtime_error("Document is nested too deeply to encode") {}
+};
+
+// How EncodeBinary() writes strings.
+enum struct StringEncoding : std::uint8_t {
+    // Every string where it occurs.
+    Inline = 0,
+    // Repeated strings once, with references to them.
+    Dictionary,
+};
+
+namespace detail {
+namespace binary {
+
+enum struct Tag : std::uint8_t {
+    Null = 0,
+    False,
+    True,
+    Integer,
+    Number,
+    String,
+    Blob,
+    Array,
+    Object,
+    Undefined,
+    Dictionary,
+    StringRef,
+};
+
+// Deeper documents are rejected rather than risk overflowing the stack, and
+// are never written, so that everything encoded can be decoded.
+static constexpr std::size_t MaxDepth = 512;
+
+// Longer strings are always written inline. With the two bytes a reference
+// takes at least, this bounds how far references can expand a document.
+static constexpr std::size_t MaxTableStringSize = 64;
+static constexpr std::size_t MaxReferenceExpansion = MaxTableStringSize / 2;
+
+// Throws unless every value in `value`, taken to be at `depth`, is within
+// MaxDepth.
+template <class DynamicType>
+void CheckDepth(const DynamicType& value, const std::size_t depth) {
+    if (depth > MaxDepth) {
+        throw BinaryDepthException();
+    }
+    if (value.IsArray()) {
+        for (const auto& element : value.GetArray()) {
+            CheckDepth(element, depth + 1);
+        }
+    } else if (value.IsObject()) {
+        for (const auto& member : value.GetObject()) {
+            CheckDepth(member.second, depth + 1);
+        }
+    }
+}
+
+inline void PutTag(std::string& out, const Tag tag) {
+    out.push_back(static_cast<char>(tag));
+}
+
+inline void PutVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+inline void PutFixed64(std::string& out, const std::uint64_t value) {
+    char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.append(bytes, sizeof(bytes));
+}
+
+inline void PutBytes(std::string& out, const void* data,
+                     const std::size_t size) {
+    PutVarint(out, size);
+    out.append(static_cast<const char*>(data), size);
+}
+
+inline std::uint64_t ZigZag(const std::int64_t value) noexcept {
+    return (static_cast<std::uint64_t>(value) << 1) ^
+           static_cast<std::uint64_t>(value >> 63);
+}
+inline std::int64_t UnZigZag(const std::uint64_t value) noexcept {
+    return static_cast<std::int64_t>(value >> 1) ^
+           -static_cast<std::int64_t>(value & 1);
+}
+
+// Reads from [begin, end), reporting errors by their offset from `begin`.
+class Reader {
+   public:
+    Reader(const char* begin, const char* end) noexcept
+        : begin_(begin), position_(begin), end_(end) {}
+
+    DNODISCARD bool AtEnd() const noexcept { return position_ == end_; }
+    DNODISCARD std::size_t Remaining() const noexcept {
+        return static_cast<std::size_t>(end_ - position_);
+    }
+    DNODISCARD std::size_t Offset() const noexcept {
+        return static_cast<std::size_t>(position_ - begin_);
+    }
+
+    [[noreturn]] void Fail(const char* what) const {
+        throw InvalidBinaryException(what, Offset());
+    }
+
+    DNODISCARD bool Peek(const Tag tag) const noexcept {
+        return !AtEnd() && static_cast<Tag>(*position_) == tag;
+    }
+
+    std::uint8_t Byte() {
+        if (AtEnd()) {
+            Fail("Unexpected end of binary document");
+        }
+        return static_cast<std::uint8_t>(*position_++);
+    }
+
+    std::uint64_t Varint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const auto byte = Byte();
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        Fail("Varint is too long");
+    }
+
+    // A count of items that each take at least one more byte, so that a
+    // corrupt count cannot make the decoder reserve more than it reads.
+    std::size_t Count() {
+        const auto count = Varint();
+        if (count > Remaining()) {
+            Fail("Count exceeds the remaining bytes");
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    std::uint64_t Fixed64() {
+        if (Remaining() < 8) {
+            Fail("Unexpected end of binary document");
+        }
+        std::uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<std::uint64_t>(
+                         static_cast<std::uint8_t>(position_[i]))
+                     << (8 * i);
+        }
+        position_ += 8;
+        return value;
+    }
+
+    // A length-prefixed run of bytes, which stays in the input.
+    std::pair<const char*, std::size_t> Bytes() {
+        const auto size = Varint();
+        if (size > Remaining()) {
+            Fail("Length exceeds the remaining bytes");
+        }
+        const auto* data = position_;
+        position_ += size;
+        return {data, static_cast<std::size_t>(size)};
+    }
+
+   private:
+    const char* begin_;
+    const char* position_;
+    const char* end_;
+};
+
+template <class DynamicType>
+void CheckEncodable() {
+    static_assert(std::is_integral<typename DynamicType::Integer>::value,
+                  "Only built-in integers can be encoded");
+    static_assert(std::is_floating_point<typename DynamicType::Number>::value,
+                  "Only built-in numbers can be encoded");
+    static_assert(sizeof(typename DynamicType::String::value_type) == 1,
+                  "Only strings of bytes can be encoded");
+}
+
+// The strings of a document written with StringEncoding::Dictionary.
+struct StringTable {
+    // Every distinct string in the document, with how often it occurs.
+    StringDictionary strings;
+    std::vector<std::uint64_t> counts;
+    // By code in `strings`: one past the position of the string in the
+    // table, or 0 for a string that is written inline.
+    std::vector<std::uint64_t> positions;
+};
+
+inline void PutString(std::string& out, const StringDictionary::View string,
+                      const StringTable* table) {
+    StringDictionary::Code code;
+    if (table != nullptr && table->strings.Find(string, code) &&
+        table->positions[code] != 0) {
+        PutTag(out, Tag::StringRef);
+        PutVarint(out, table->positions[code] - 1);
+        return;
+    }
+    PutTag(out, Tag::String);
+    PutBytes(out, string.data(), string.size());
+}
+
+template <class DynamicType>
+void CountStrings(const DynamicType& value, StringTable& table,
+                  const std::size_t depth) {
+    if (depth > MaxDepth) {
+        throw BinaryDepthException();
+    }
+    using Char = typename DynamicType::String::value_type;
+    if (value.IsString() || value.IsStringView()) {
+        const auto intern = [&table](const Char* data,
+                                     const std::size_t size) {
+            return table.strings.Intern(StringDictionary::View(data, size));
+        };
+        const auto code =
+            value.IsString()
+                ? detail::WithContiguous(value.GetString(), intern)
+                : intern(value.GetStringView().data(),
+                         value.GetStringView().size());
+        if (code == table.counts.size()) {
+            table.counts.push_back(0);
+        }
+        ++table.counts[code];
+    } else if (value.IsArray()) {
+        for (const auto& element : value.GetArray()) {
+            CountStrings(element, table, depth + 1);
+        }
+    } else if (value.IsObject()) {
+        for (const auto& member : value.GetObject()) {
+            CountStrings(member.second, table, depth + 1);
+        }
+    }
+}
+
+// Writes the table of the short strings that occur more than once, most
+// frequent first.
+inline void PutStringTable(std::string& out, StringTable& table) {
+    std::vector<StringDictionary::Code> repeated;
+    for (std::size_t code = 0; code < table.counts.size(); ++code) {
+        const auto code_of = static_cast<StringDictionary::Code>(code);
+        if (table.counts[code] > 1 &&
+            table.strings.At(code_of).size() <= MaxTableStringSize) {
+            repeated.push_back(static_cast<StringDictionary::Code>(code));
+        }
+    }
+    std::stable_sort(repeated.begin(), repeated.end(),
+                     [&table](const StringDictionary::Code lhs,
+                              const StringDictionary::Code rhs) {
+                         return table.counts[lhs] > table.counts[rhs];
+                     });
+    table.positions.assign(table.counts.size(), 0);
+    PutTag(out, Tag::Dictionary);
+    PutVarint(out, repeated.size());
+    for (std::size_t i = 0; i < repeated.size(); ++i) {
+        const auto string = table.strings.At(repeated[i]);
+        PutBytes(out, string.data(), string.size());
+        table.positions[repeated[i]] = i + 1;
+    }
+}
+
+template <class DynamicType>
+void Encode(const DynamicType& value, std::string& out,
+            const StringTable* table, const std::size_t depth) {
+    if (depth > MaxDepth) {
+        throw BinaryDepthException();
+    }
+    if (value.IsNull()) {
+        PutTag(out, Tag::Null);
+    } else if (value.IsBoolean()) {
+        PutTag(out, value.GetBoolean() ? Tag::True : Tag::False);
+    } else if (value.IsInteger()) {
+        PutTag(out, Tag::Integer);
+        PutVarint(out, ZigZag(static_cast<std::int64_t>(value.GetInteger())));
+    } else if (value.IsNumber()) {
+        const auto number = static_cast<double>(value.GetNumber());
+        std::uint64_t bits;
+        std::memcpy(&bits, &number, sizeof(bits));
+        PutTag(out, Tag::Number);
+        PutFixed64(out, bits);
+    } else if (value.IsString()) {
+        using Char = typename DynamicType::String::value_type;
+        detail::WithContiguous(
+            value.GetString(),
+            [&out, table](const Char* data, const std::size_t size) {
+                PutString(out, StringDictionary::View(data, size), table);
+            });
+    } else if (value.IsStringView()) {
+        const auto view = value.GetStringView();
+        PutString(out, StringDictionary::View(view.data(), view.size()),
+                  table);
+    } else if (value.IsBlob()) {
+        const auto& blob = value.GetBlob();
+        PutTag(out, Tag::Blob);
+        PutBytes(out, blob.data(), blob.size() * sizeof(*blob.data()));
+    } else if (value.IsBlobView()) {
+        const auto view = value.GetBlobView();
+        PutTag(out, Tag::Blob);
+        PutBytes(out, view.data(), view.size() * sizeof(*view.data()));
+    } else if (value.IsArray()) {
+        const auto& array = value.GetArray();
+        PutTag(out, Tag::Array);
+        PutVarint(out, array.size());
+        for (const auto& element : array) {
+            Encode(element, out, table, depth + 1);
+        }
+    } else if (value.IsObject()) {
+        const auto& object = value.GetObject();
+        PutTag(out, Tag::Object);
+        PutVarint(out, object.size());
+        for (const auto& member : object) {
+            PutBytes(out, member.first.data(), member.first.size());
+            Encode(member.second, out, table, depth + 1);
+        }
+    } else {
+        PutTag(out, Tag::Undefined);
+    }
+}
+
+// The table of a dictionary-encoded document, which stays in the input,
+// where to intern the strings decoded, if anywhere, and how many more bytes
+// references may still expand to.
+struct DecodeContext {
+    std::vector<std::pair<const char*, std::size_t>> strings;
+    StringDictionary* dictionary = nullptr;
+    std::size_t reference_budget = 0;
+};
+
+// How many bytes the references of a document of `size` bytes may expand to.
+inline std::size_t ReferenceBudget(const std::size_t size) noexcept {
+    return size <= static_cast<std::size_t>(-1) / MaxReferenceExpansion
+               ? size * MaxReferenceExpansion
+               : static_cast<std::size_t>(-1);
+}
+
+template <class DynamicType>
+DynamicType MakeString(const std::pair<const char*, std::size_t> bytes,
+                       const DecodeContext& context) {
+    if (context.dictionary != nullptr &&
+        bytes.second <= context.dictionary->MaxSize()) {
+        const auto interned = context.dictionary->At(
+            context.dictionary->Intern(StringDictionary::View(
+                bytes.first, bytes.second)));
+        return DynamicType::template From<typename DynamicType::StringView>(
+            typename DynamicType::StringView(interned.data(),
+                                             interned.size()));
+    }
+    typename DynamicType::String string(bytes.first, bytes.second);
+    return DynamicType::template From<typename DynamicType::String>(
+        std::move(string));
+}
+
+template <class DynamicType>
+DynamicType Decode(Reader& reader, DecodeContext& context,
+                   const std::size_t depth) {
+    if (depth > MaxDepth) {
+        reader.Fail("Binary document is nested too deeply");
+    }
+    switch (static_cast<Tag>(reader.Byte())) {
+        case Tag::Null:
+            return DynamicType::template From<typename DynamicType::Null>();
+        case Tag::False:
+            return DynamicType::template From<typename DynamicType::Boolean>(
+                false);
+        case Tag::True:
+            return DynamicType::template From<typename DynamicType::Boolean>(
+                true);
+        case Tag::Integer:
+            return DynamicType::template From<typename DynamicType::Integer>(
+                static_cast<typename DynamicType::Integer>(
+                    UnZigZag(reader.Varint())));
+        case Tag::Number: {
+            const auto bits = reader.Fixed64();
+            double number;
+            std::memcpy(&number, &bits, sizeof(number));
+            return DynamicType::template From<typename DynamicType::Number>(
+                static_cast<typename DynamicType::Number>(number));
+        }
+        case Tag::String:
+            return MakeString<DynamicType>(reader.Bytes(), context);
+        case Tag::StringRef: {
+            const auto position = reader.Varint();
+            if (position >= context.strings.size()) {
+                reader.Fail("String reference is not in the dictionary");
+            }
+            const auto string =
+                context.strings[static_cast<std::size_t>(position)];
+            if (string.second > context.reference_budget) {
+                reader.Fail("String references expand beyond the size limit");
+            }
+            context.reference_budget -= string.second;
+            return MakeString<DynamicType>(string, context);
+        }
+        case Tag::Blob: {
+            using Byte = typename DynamicType::Blob::value_type;
+            static_assert(sizeof(Byte) == 1, "Blobs are decoded as bytes");
+            const auto bytes = reader.Bytes();
+            const auto* data = reinterpret_cast<const Byte*>(bytes.first);
+            typename DynamicType::Blob blob(data, data + bytes.second);
+            return DynamicType::template From<typename DynamicType::Blob>(
+                std::move(blob));
+        }
+        case Tag::Array: {
+            const auto count = reader.Count();
+            auto array =
+                DynamicType::template From<typename DynamicType::Array>();
+            auto& elements = array.GetArray();
+            detail::reserve(elements, count);
+            for (std::size_t i = 0; i < count; ++i) {
+                elements.push_back(
+                    Decode<DynamicType>(reader, context, depth + 1));
+            }
+            return array;
+        }
+        case Tag::Object: {
+            const auto count = reader.Count();
+            typename DynamicType::ObjectBuilder builder;
+            builder.Reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto key = reader.Bytes();
+                builder.Add(std::string(key.first, key.second),
+                            Decode<DynamicType>(reader, context, depth + 1));
+            }
+            return builder.Finish();
+        }
+        case Tag::Undefined:
+            return DynamicType::template From<
+                typename DynamicType::Undefined>();
+        default:
+            reader.Fail("Unknown tag in binary document");
+    }
+}
+
+// A document, with its string table if it has one.
+template <class DynamicType>
+DynamicType DecodeDocument(Reader& reader, DecodeContext& context) {
+    if (reader.Peek(Tag::Dictionary)) {
+        (void)reader.Byte();
+        const auto count = reader.Count();
+        context.strings.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            context.strings.push_back(reader.Bytes());
+        }
+    }
+    return Decode<DynamicType>(reader, context, 0);
+}
+
+template <class DynamicType>
+DynamicType DecodeAll(const char* data, const std::size_t size,
+                      StringDictionary* dictionary) {
+    CheckEncodable<DynamicType>();
+    Reader reader(data, data + size);
+    DecodeContext context;
+    context.dictionary = dictionary;
+    context.reference_budget = ReferenceBudget(size);
+    auto value = DecodeDocument<DynamicType>(reader, context);
+    if (!reader.AtEnd()) {
+        reader.Fail("Trailing bytes after binary document");
+    }
+    return value;
+}
+
+}  // namespace binary
+}  // namespace detail
+
+// Appends the encoding of `value` to `out`. The dictionary encoding reads
+// the document twice, first to count its strings. Throws
+// BinaryDepthException, leaving `out` as it was, if `value` is nested too
+// deeply to be decoded.
+template <class DynamicType>
+void EncodeBinary(const DynamicType& value, std::string& out,
+                  const StringEncoding encoding = StringEncoding::Inline) {
+    detail::binary::CheckEncodable<DynamicType>();
+    if (encoding == StringEncoding::Dictionary) {
+        // Counting the strings checks the depth before anything is written.
+        detail::binary::StringTable table;
+        detail::binary::CountStrings(value, table, 0);
+        detail::binary::PutStringTable(out, table);
+        detail::binary::Encode(value, out, &table, 0);
+        return;
+    }
+    const auto size = out.size();
+    try {
+        detail::binary::Encode(value, out, nullptr, 0);
+    } catch (...) {
+        out.resize(size);
+        throw;
+    }
+}
+template <class DynamicType>
+DNODISCARD std::string EncodeBinary(
+    const DynamicType& value,
+    const StringEncoding encoding = StringEncoding::Inline) {
+    std::string out;
+    EncodeBinary(value, out, encoding);
+    return out;
+}
+
+// Decodes the single document in [data, data + size), in either string
+// encoding. Throws InvalidBinaryException if the bytes are not exactly one
+// encoded document.
+template <class DynamicType>
+DNODISCARD DynamicType DecodeBinary(const char* data, const std::size_t size) {
+    return detail::binary::DecodeAll<DynamicType>(data, size, nullptr);
+}
+template <class DynamicType>
+DNODISCARD DynamicType DecodeBinary(const std::string& bytes) {
+    return DecodeBinary<DynamicType>(bytes.data(), bytes.size());
+}
+
+// As above, but with the strings of the document interned in `dictionary`,
+// as by StringDictionary::Encode(). The document borrows from `dictionary`.
+template <class DynamicType>
+DNODISCARD DynamicType DecodeBinary(const char* data, const std::size_t size,
+                                    StringDictionary& dictionary) {
+    return detail::binary::DecodeAll<DynamicType>(data, size, &dictionary);
+}
+template <class DynamicType>
+DNODISCARD DynamicType DecodeBinary(const std::string& bytes,
+                                    StringDictionary& dictionary) {
+    return DecodeBinary<DynamicType>(bytes.data(), bytes.size(), dictionary);
+}
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_BINARY_H
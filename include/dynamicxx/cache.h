@@ -0,0 +1,279 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A thread-safe cache of documents, bounded by the memory they use.
+//
+// Each entry is charged the MemoryUsage() of its document, so one large
+// document can push out many small ones. When a put takes a shard over its
+// share of the budget, the least recently used entries of that shard are
+// evicted. Keys are spread over independently locked shards, so threads
+// working on different keys rarely contend.
+//
+// Documents are held as shared, immutable handles: a hit hands out a
+// reference to the cached document without copying it, and an evicted
+// document lives on for as long as a reader still holds it. Entries that are
+// removed are released after the shard's lock, so that destroying a document
+// never holds up the readers of its shard.
+
+#ifndef DYNAMICXX_CACHE_H
+#define DYNAMICXX_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+
+struct CacheOptions {
+    // The most memory the cached documents may use, as measured by
+    // MemoryUsage(), plus a fixed cost per entry.
+    std::size_t byte_budget = std::size_t{64} << 20;
+    // Rounded up to a power of two. Each shard gets an equal part of the
+    // budget, so a document larger than that part is never cached.
+    std::size_t shards = 16;
+};
+
+struct CacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t insertions = 0;
+    std::uint64_t evictions = 0;
+    // Documents too large for their shard's budget.
+    std::uint64_t rejections = 0;
+
+    std::size_t entries = 0;
+    std::size_t bytes = 0;
+};
+
+namespace detail {
+namespace cache {
+
+template <class Key>
+std::size_t KeyBytes(const Key&) noexcept {
+    return 0;
+}
+template <class Char, class Traits, class Allocator>
+std::size_t KeyBytes(const std::basic_string<Char, Traits, Allocator>& key) {
+    return memory::StringHeapBytes(key);
+}
+
+}  // namespace cache
+}  // namespace detail
+
+template <class Key, class DynamicType = Dynamic, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class DynamicCache {
+   public:
+    // Shared and immutable, so that readers never copy the document. Clone()
+    // it to get a copy to modify.
+    using Handle = std::shared_ptr<const DynamicType>;
+
+    explicit DynamicCache(const CacheOptions& options = CacheOptions())
+        : shard_count_(ShardsFor(options.shards)),
+          shard_budget_(options.byte_budget / shard_count_),
+          shards_(new Shard[shard_count_]) {}
+
+    DynamicCache(const DynamicCache&) = delete;
+    DynamicCache& operator=(const DynamicCache&) = delete;
+
+    // The document cached under `key`, or null.
+    DNODISCARD Handle Get(const Key& key) {
+        auto& shard = ShardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            ++shard.stats.misses;
+            return nullptr;
+        }
+        ++shard.stats.hits;
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return it->second->value;
+    }
+
+    // Caches `value` under `key`, replacing any document already there, and
+    // returns a handle to it. The handle is returned even if the document is
+    // too large to cache.
+    Handle Put(const Key& key, DynamicType value) {
+        return Put(key, std::make_shared<const DynamicType>(std::move(value)));
+    }
+    Handle Put(const Key& key, Handle value) {
+        if (value == nullptr) {
+            throw std::invalid_argument("Cannot cache a null document");
+        }
+        const auto charge = ChargeFor(key, *value);
+        auto& shard = ShardOf(key);
+        EntryList released;
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            Remove(shard, it, released);
+        }
+        if (charge > shard_budget_) {
+            ++shard.stats.rejections;
+            return value;
+        }
+        while (shard.bytes + charge > shard_budget_) {
+            ++shard.stats.evictions;
+            Remove(shard, shard.index.find(shard.entries.back().key),
+                   released);
+        }
+        shard.entries.push_front(Entry{key, value, charge});
+        shard.index.emplace(key, shard.entries.begin());
+        shard.bytes += charge;
+        ++shard.stats.insertions;
+        return value;
+    }
+
+    // The document cached under `key`, or else the one returned by `make()`,
+    // which is cached. `make` runs without a lock held, so two threads that
+    // miss on the same key at once may both call it; the later put wins.
+    template <class Make>
+    Handle GetOrPut(const Key& key, Make&& make) {
+        auto value = Get(key);
+        if (value != nullptr) {
+            return value;
+        }
+        return Put(key, std::forward<Make>(make)());
+    }
+
+    // Returns whether there was a document under `key`.
+    bool Erase(const Key& key) {
+        auto& shard = ShardOf(key);
+        EntryList released;
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return false;
+        }
+        Remove(shard, it, released);
+        return true;
+    }
+
+    void Clear() {
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            auto& shard = shards_[i];
+            EntryList released;
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.index.clear();
+            released.splice(released.end(), shard.entries);
+            shard.bytes = 0;
+        }
+    }
+
+    // Totals over every shard. Each shard is read under its own lock, so the
+    // totals are not a snapshot while other threads use the cache.
+    DNODISCARD CacheStats Stats() const {
+        CacheStats total;
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            const auto& shard = shards_[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total.hits += shard.stats.hits;
+            total.misses += shard.stats.misses;
+            total.insertions += shard.stats.insertions;
+            total.evictions += shard.stats.evictions;
+            total.rejections += shard.stats.rejections;
+            total.entries += shard.index.size();
+            total.bytes += shard.bytes;
+        }
+        return total;
+    }
+
+    DNODISCARD std::size_t ByteBudget() const noexcept {
+        return shard_budget_ * shard_count_;
+    }
+    DNODISCARD std::size_t ShardCount() const noexcept { return shard_count_; }
+
+   private:
+    struct Entry {
+        Key key;
+        Handle value;
+        std::size_t charge;
+    };
+    using EntryList = std::list<Entry>;
+    using Index = std::unordered_map<Key, typename EntryList::iterator, Hash,
+                                     KeyEqual>;
+
+    // Most recently used first.
+    struct Shard {
+        mutable std::mutex mutex;
+        EntryList entries;
+        Index index;
+        std::size_t bytes = 0;
+        CacheStats stats;
+    };
+
+    // A list node and an index node per entry, on top of the document and
+    // its key.
+    static constexpr std::size_t EntryOverhead =
+        sizeof(Entry) + 2 * sizeof(void*) + sizeof(typename Index::value_type) +
+        2 * sizeof(void*);
+
+    static std::size_t ShardsFor(const std::size_t shards) {
+        if (shards == 0 || shards > 4096) {
+            throw std::invalid_argument("Invalid number of cache shards");
+        }
+        std::size_t rounded = 1;
+        while (rounded < shards) {
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+    static std::size_t ChargeFor(const Key& key, const DynamicType& value) {
+        return value.MemoryUsage().Total() +
+               2 * detail::cache::KeyBytes(key) + EntryOverhead;
+    }
+
+    // The hash is mixed before choosing a shard, so that the shard and the
+    // bucket within it do not depend on the same bits.
+    Shard& ShardOf(const Key& key) const {
+        const auto hash = static_cast<std::uint64_t>(Hash{}(key));
+        const auto mixed = hash * 0x9E3779B97F4A7C15U;
+        return shards_[static_cast<std::size_t>(mixed >> 32) &
+                       (shard_count_ - 1)];
+    }
+
+    // Moves the entry to `released`, which the caller declares before taking
+    // the lock so that the document is destroyed only once it is unlocked.
+    // Splicing neither allocates nor throws.
+    static void Remove(Shard& shard, const typename Index::iterator it,
+                       EntryList& released) {
+        shard.bytes -= it->second->charge;
+        released.splice(released.end(), shard.entries, it->second);
+        shard.index.erase(it);
+    }
+
+    const std::size_t shard_count_;
+    const std::size_t shard_budget_;
+    const std::unique_ptr<Shard[]> shards_;
+};
+
+template <class Key, class DynamicType, class Hash, class KeyEqual>
+constexpr std::size_t
+    DynamicCache<Key, DynamicType, Hash, KeyEqual>::EntryOverhead;
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_CACHE_H
@@ -0,0 +1,177 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Dictionary encoding of the strings in documents.
+//
+// Documents such as logs repeat a few short strings, like a level or a region,
+// in every record. A StringDictionary stores each distinct string once and
+// numbers it; Encode() then replaces the strings of a document with
+// StringViews of the dictionary's copies. Every occurrence of a string is
+// then the same view, so two of them compare equal without looking at their
+// characters, and CodeOf() turns one into its number for grouping or
+// counting.
+//
+// The document borrows from the dictionary, which must outlive it or be
+// detached with BasicDynamic::Materialize().
+
+#ifndef DYNAMICXX_DICTIONARY_H
+#define DYNAMICXX_DICTIONARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+namespace detail {
+namespace dictionary {
+
+using View = StringView<char>;
+
+// FNV-1a.
+struct ViewHash {
+    std::size_t operator()(const View& view) const noexcept {
+        std::uint64_t hash = 0xCBF29CE484222325U;
+        for (const char c : view) {
+            hash = (hash ^ static_cast<std::uint8_t>(c)) * 0x100000001B3U;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+};
+
+}  // namespace dictionary
+}  // namespace detail
+
+class StringDictionary {
+   public:
+    using Code = std::uint32_t;
+    using View = detail::dictionary::View;
+
+    // Encode() and the binary decoder only intern strings of at most
+    // `max_size` bytes, as longer ones are rarely repeated.
+    explicit StringDictionary(const std::size_t max_size = 64)
+        : max_size_(max_size) {}
+
+    // Views of the strings would dangle in a copy.
+    StringDictionary(const StringDictionary&) = delete;
+    StringDictionary& operator=(const StringDictionary&) = delete;
+    StringDictionary(StringDictionary&&) = default;
+    StringDictionary& operator=(StringDictionary&&) = default;
+
+    DNODISCARD std::size_t size() const noexcept { return strings_.size(); }
+    DNODISCARD std::size_t MaxSize() const noexcept { return max_size_; }
+
+    // The code of `string`, added if it is not there yet. Codes are given out
+    // from 0 in the order strings are first added.
+    Code Intern(const View string) {
+        const auto it = codes_.find(string);
+        if (it != codes_.end()) {
+            return it->second;
+        }
+        if (strings_.size() >= MaxCodes) {
+            throw std::length_error("StringDictionary is full");
+        }
+        const auto code = static_cast<Code>(strings_.size());
+        // A deque never moves its elements, so views of them stay valid.
+        strings_.emplace_back(string.data(), string.size());
+        const View stored(strings_.back().data(), strings_.back().size());
+        codes_.emplace(stored, code);
+        by_address_.emplace(stored.data(), code);
+        return code;
+    }
+
+    // Whether `string` has been added, and if so its code.
+    DNODISCARD bool Find(const View string, Code& code) const {
+        const auto it = codes_.find(string);
+        if (it == codes_.end()) {
+            return false;
+        }
+        code = it->second;
+        return true;
+    }
+
+    // The dictionary's copy of the string with `code`.
+    DNODISCARD View At(const Code code) const {
+        if (code >= strings_.size()) {
+            throw std::out_of_range("No string with this code");
+        }
+        const auto& string = strings_[code];
+        return View(string.data(), string.size());
+    }
+
+    // The code of a view returned by At(), or put in a document by Encode(),
+    // found from its address alone. Throws std::invalid_argument for any
+    // other view.
+    DNODISCARD Code CodeOf(const View interned) const {
+        const auto it = by_address_.find(interned.data());
+        if (it == by_address_.end() ||
+            strings_[it->second].size() != interned.size()) {
+            throw std::invalid_argument("String is not from this dictionary");
+        }
+        return it->second;
+    }
+
+    // Replaces every string value in `document` of at most MaxSize() bytes,
+    // owned or borrowed, with a view of its copy in this dictionary. Object
+    // keys are left alone. Returns the number of values replaced.
+    template <class DynamicType>
+    std::size_t Encode(DynamicType& document) {
+        static_assert(
+            sizeof(typename DynamicType::String::value_type) == 1,
+            "Only strings of bytes can be dictionary encoded");
+        if (document.IsString() || document.IsStringView()) {
+            const auto view = document.IsString()
+                                  ? View(document.GetString().data(),
+                                         document.GetString().size())
+                                  : View(document.GetStringView().data(),
+                                         document.GetStringView().size());
+            if (view.size() > max_size_) {
+                return 0;
+            }
+            const auto interned = At(Intern(view));
+            document = typename DynamicType::StringView(interned.data(),
+                                                        interned.size());
+            return 1;
+        }
+        std::size_t replaced = 0;
+        if (document.IsArray()) {
+            for (auto&& element : document.GetArray()) {
+                replaced += Encode(element);
+            }
+        } else if (document.IsObject()) {
+            for (auto&& member : document.GetObject()) {
+                replaced += Encode(member.second);
+            }
+        }
+        return replaced;
+    }
+
+   private:
+    static constexpr std::size_t MaxCodes = 0xFFFFFFFFU;
+
+    std::size_t max_size_;
+    std::deque<std::string> strings_;
+    std::unordered_map<View, Code, detail::dictionary::ViewHash> codes_;
+    std::unordered_map<const char*, Code> by_address_;
+};
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_DICTIONARY_H
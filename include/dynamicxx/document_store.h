@@ -0,0 +1,694 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A document kept durable on disk by logging each change to it.
+//
+// A DocumentStore owns a directory holding two files: `snapshot`, the whole
+// document in the dictionary encoding of binary.h, and `log`, the changes made
+// since, each a small record naming a path and, for Set and Push, the new
+// value.
+// Changing the document appends a record to the log instead of rewriting the
+// document, and Snapshot() folds the log back into a new snapshot.
+//
+// A change returns once its record is on disk. Threads that change the
+// document at the same time share a single write and fsync: whichever of them
+// finds no write in progress writes every pending record, while the others
+// wait for it. The more writers, the more records each fsync covers.
+//
+// Open() recovers the document by replaying the log over the snapshot. A
+// record cut short by a crash, or whose checksum does not match, ends the log;
+// it and anything after it are discarded. Snapshots are written to a
+// temporary file and renamed into place, and each one starts a new generation
+// of the log, so a crash part way through never replays changes twice.
+
+#ifndef DYNAMICXX_DOCUMENT_STORE_H
+#define DYNAMICXX_DOCUMENT_STORE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dynamicxx/binary.h"
+#include "dynamicxx/dynamicxx.h"
+#include "dynamicxx/shared_blob.h"
+
+namespace dynamicxx {
+
+// One step into a document: an object key, or an array index.
+class PathStep {
+   public:
+    PathStep(std::string key) : key_(std::move(key)), index_(0) {}
+    PathStep(const char* key) : key_(key), index_(0) {}
+    template <class Index,
+              typename std::enable_if<std::is_integral<Index>::value,
+                                      int>::type = 0>
+    PathStep(const Index index)
+        : is_index_(true), index_(static_cast<std::size_t>(index)) {
+        if (IsNegative(index, std::is_signed<Index>())) {
+            throw std::out_of_range("Negative index in path");
+        }
+    }
+
+    DNODISCARD bool IsIndex() const noexcept { return is_index_; }
+    DNODISCARD const std::string& Key() const noexcept { return key_; }
+    DNODISCARD std::size_t Index() const noexcept { return index_; }
+
+   private:
+    template <class Index>
+    static bool IsNegative(const Index index, std::true_type) noexcept {
+        return index < 0;
+    }
+    template <class Index>
+    static bool IsNegative(const Index, std::false_type) noexcept {
+        return false;
+    }
+
+    bool is_index_ = false;
+    std::string key_;
+    std::size_t index_;
+};
+
+// The steps from the root of a document to a value; empty for the root.
+using DocumentPath = std::vector<PathStep>;
+
+struct DocumentStoreOptions {
+    // Whether a change waits for its record to reach the disk, rather than
+    // just the operating system. Without it, a crash of the machine (but not
+    // of the process) can lose the latest changes.
+    bool sync = true;
+    // Snapshot() automatically once the log grows past this many bytes; 0
+    // never does.
+    std::size_t snapshot_log_bytes = std::size_t{64} << 20;
+};
+
+struct DocumentStoreStats {
+    // Changes logged, and the writes that put them on disk.
+    std::uint64_t records = 0;
+    std::uint64_t commits = 0;
+    std::uint64_t snapshots = 0;
+    std::size_t log_bytes = 0;
+};
+
+namespace detail {
+namespace store {
+
+enum struct Operation : std::uint8_t { Set = 1, Erase, Push };
+
+static constexpr char LogMagic[] = "DXXLOG01";
+static constexpr char SnapshotMagic[] = "DXXSNP01";
+static constexpr std::size_t MagicSize = 8;
+// Magic and generation.
+static constexpr std::size_t LogHeaderSize = MagicSize + 8;
+// Magic, generation, length and checksum.
+static constexpr std::size_t SnapshotHeaderSize = MagicSize + 8 + 8 + 4;
+// Length and checksum.
+static constexpr std::size_t RecordHeaderSize = 8;
+
+// CRC-32 (IEEE), as used by zlib.
+inline std::uint32_t Crc32(const char* data, const std::size_t size) noexcept {
+    static const struct Table {
+        std::uint32_t entries[256];
+        Table() noexcept {
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                auto crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0xEDB88320U : 0);
+                }
+                entries[i] = crc;
+            }
+        }
+    } table;
+    std::uint32_t crc = 0xFFFFFFFFU;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table.entries[(crc ^ static_cast<std::uint8_t>(data[i])) & 0xFF] ^
+              (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+inline void PutFixed32(std::string& out, const std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+}
+inline std::uint64_t GetFixed(const char* data, const int bytes) noexcept {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(data[i]))
+                 << (8 * i);
+    }
+    return value;
+}
+
+inline void PutPath(std::string& out, const DocumentPath& path) {
+    binary::PutVarint(out, path.size());
+    for (const auto& step : path) {
+        if (step.IsIndex()) {
+            out.push_back(1);
+            binary::PutVarint(out, step.Index());
+        } else {
+            out.push_back(0);
+            binary::PutBytes(out, step.Key().data(), step.Key().size());
+        }
+    }
+}
+inline DocumentPath GetPath(binary::Reader& reader) {
+    DocumentPath path;
+    const auto size = reader.Count();
+    path.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        if (reader.Byte() != 0) {
+            path.emplace_back(static_cast<std::size_t>(reader.Varint()));
+        } else {
+            const auto key = reader.Bytes();
+            path.emplace_back(std::string(key.first, key.second));
+        }
+    }
+    return path;
+}
+
+// The value at `path`, which must exist.
+template <class DynamicType>
+DynamicType& Resolve(DynamicType& root, const DocumentPath& path,
+                     const std::size_t length) {
+    auto* current = &root;
+    for (std::size_t i = 0; i < length; ++i) {
+        const auto& step = path[i];
+        if (step.IsIndex()) {
+            auto& array = current->GetArray();
+            if (step.Index() >= array.size()) {
+                throw std::out_of_range("Path index is out of range");
+            }
+            current = &array[step.Index()];
+        } else {
+            auto& object = current->GetObject();
+            const auto it = object.find(step.Key());
+            if (it == object.end()) {
+                throw std::out_of_range("Path key is not in the document");
+            }
+            current = &it->second;
+        }
+    }
+    return *current;
+}
+
+// Applies a change, which either succeeds or leaves `root` as it was.
+template <class DynamicType>
+void Apply(DynamicType& root, const Operation operation,
+           const DocumentPath& path, DynamicType&& value) {
+    if (operation == Operation::Push) {
+        Resolve(root, path, path.size()).GetArray().push_back(std::move(value));
+        return;
+    }
+    if (path.empty()) {
+        if (operation == Operation::Erase) {
+            throw std::invalid_argument("Cannot erase the root");
+        }
+        root = std::move(value);
+        return;
+    }
+    auto& parent = Resolve(root, path, path.size() - 1);
+    const auto& last = path.back();
+    if (last.IsIndex()) {
+        auto& array = parent.GetArray();
+        if (last.Index() >= array.size()) {
+            throw std::out_of_range("Path index is out of range");
+        }
+        if (operation == Operation::Set) {
+            array[last.Index()] = std::move(value);
+        } else {
+            array.erase(array.begin() +
+                        static_cast<std::ptrdiff_t>(last.Index()));
+        }
+    } else {
+        auto& object = parent.GetObject();
+        if (operation == Operation::Set) {
+            object[last.Key()] = std::move(value);
+        } else if (object.erase(last.Key()) == 0) {
+            throw std::out_of_range("Path key is not in the document");
+        }
+    }
+}
+
+#if DYNAMICXX_HAS_MMAP
+class File {
+   public:
+    File() noexcept : descriptor_(-1) {}
+    File(const std::string& path, const int flags)
+        : descriptor_(::open(path.c_str(), flags | O_CLOEXEC, 0644)) {
+        if (descriptor_ < 0) {
+            ThrowSystemError("Failed to open document store file");
+        }
+    }
+    ~File() {
+        if (descriptor_ >= 0) {
+            ::close(descriptor_);
+        }
+    }
+
+    File(File&& that) noexcept : descriptor_(that.descriptor_) {
+        that.descriptor_ = -1;
+    }
+    File& operator=(File&& that) noexcept {
+        std::swap(descriptor_, that.descriptor_);
+        return *this;
+    }
+
+    DNODISCARD static bool Exists(const std::string& path) {
+        struct stat status;
+        return ::stat(path.c_str(), &status) == 0;
+    }
+
+    DNODISCARD std::string ReadAll() const {
+        std::string contents;
+        char buffer[64 * 1024];
+        for (;;) {
+            const auto count = ::read(descriptor_, buffer, sizeof(buffer));
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ThrowSystemError("Failed to read document store file");
+            }
+            if (count == 0) {
+                return contents;
+            }
+            contents.append(buffer, static_cast<std::size_t>(count));
+        }
+    }
+
+    void WriteAll(const char* data, std::size_t size) const {
+        while (size > 0) {
+            const auto count = ::write(descriptor_, data, size);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ThrowSystemError("Failed to write document store file");
+            }
+            data += count;
+            size -= static_cast<std::size_t>(count);
+        }
+    }
+
+    void Sync() const {
+#if defined(__APPLE__)
+        const int result = ::fsync(descriptor_);
+#else
+        const int result = ::fdatasync(descriptor_);
+#endif
+        if (result != 0) {
+            ThrowSystemError("Failed to sync document store file");
+        }
+    }
+
+    void Truncate(const std::size_t size) const {
+        if (::ftruncate(descriptor_, static_cast<off_t>(size)) != 0) {
+            ThrowSystemError("Failed to truncate document store file");
+        }
+    }
+
+    // Makes a rename within `directory` durable.
+    static void SyncDirectory(const std::string& directory) {
+        const File file(directory, O_RDONLY);
+        if (::fsync(file.descriptor_) != 0) {
+            ThrowSystemError("Failed to sync document store directory");
+        }
+    }
+
+    // Writes `contents` to `path` by way of a temporary file, so that `path`
+    // holds either its old contents or all of the new ones.
+    static void Replace(const std::string& directory, const std::string& path,
+                        const std::string& contents) {
+        Install(directory, Prepare(path, contents), path);
+    }
+
+    // The first half of Replace(): writes and syncs the temporary file, and
+    // returns its path. `path` is untouched, even if this throws.
+    static std::string Prepare(const std::string& path,
+                               const std::string& contents) {
+        auto temporary = path + ".tmp";
+        File file(temporary, O_WRONLY | O_CREAT | O_TRUNC);
+        file.WriteAll(contents.data(), contents.size());
+        file.Sync();
+        return temporary;
+    }
+
+    // The second half: renames `temporary` over `path`. Once called, `path`
+    // may hold the new contents even if this throws.
+    static void Install(const std::string& directory,
+                        const std::string& temporary, const std::string& path) {
+        if (::rename(temporary.c_str(), path.c_str()) != 0) {
+            ThrowSystemError("Failed to rename document store file");
+        }
+        SyncDirectory(directory);
+    }
+
+   private:
+    int descriptor_;
+};
+#endif
+
+}  // namespace store
+}  // namespace detail
+
+#if DYNAMICXX_HAS_MMAP
+// A document persisted in a directory, with its changes logged as they are
+// made. Any number of threads may change and read the document.
+template <class DynamicType = Dynamic>
+class DocumentStore {
+   public:
+    // Recovers the document in `directory`, which must exist, or starts an
+    // empty object if the directory holds no store. Throws
+    // InvalidBinaryException if the snapshot is damaged, and std::system_error
+    // if the files cannot be read or written.
+    DNODISCARD static DocumentStore Open(
+        const std::string& directory,
+        const DocumentStoreOptions& options = DocumentStoreOptions()) {
+        DocumentStore store(directory, options);
+        store.Recover();
+        return store;
+    }
+
+    DocumentStore(DocumentStore&& that) noexcept
+        : directory_(std::move(that.directory_)),
+          options_(that.options_),
+          root_(std::move(that.root_)),
+          log_(std::move(that.log_)),
+          generation_(that.generation_),
+          stats_(that.stats_) {}
+    DocumentStore& operator=(DocumentStore&&) = delete;
+
+    // Makes the value at `path` `value`. The parent of `path` must exist;
+    // an object member is added if it is missing, but an array index must be
+    // in range. Changes that would nest the document too deeply to encode
+    // throw BinaryDepthException.
+    void Set(const DocumentPath& path, DynamicType value) {
+        Change(detail::store::Operation::Set, path, std::move(value));
+    }
+    // Removes the object member or array element at `path`.
+    void Erase(const DocumentPath& path) {
+        Change(detail::store::Operation::Erase, path, DynamicType());
+    }
+    // Appends `value` to the array at `path`.
+    void Push(const DocumentPath& path, DynamicType value) {
+        Change(detail::store::Operation::Push, path, std::move(value));
+    }
+
+    // Calls `read` with the document, which must not be kept past the call.
+    template <class Reader>
+    auto Read(Reader&& reader) const
+        -> decltype(reader(std::declval<const DynamicType&>())) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reader(static_cast<const DynamicType&>(root_));
+    }
+    // A copy of the whole document.
+    DNODISCARD DynamicType Get() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return root_.Clone();
+    }
+
+    // Writes the whole document as a new snapshot and starts an empty log.
+    // Changes wait while the snapshot is written. If it fails once the new
+    // snapshot may be in place, the old log can no longer be appended to, so
+    // later changes throw until the store is reopened.
+    void Snapshot() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        committed_.wait(lock, [this] { return !committing_; });
+        CheckLog();
+        WriteSnapshot();
+    }
+
+    DNODISCARD DocumentStoreStats Stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+   private:
+    using Operation = detail::store::Operation;
+    using File = detail::store::File;
+
+    DocumentStore(std::string directory, const DocumentStoreOptions& options)
+        : directory_(std::move(directory)),
+          options_(options),
+          root_(DynamicType::template From<typename DynamicType::Object>()) {}
+
+    std::string PathOf(const char* name) const {
+        return directory_ + "/" + name;
+    }
+
+    void Recover() {
+        namespace store = detail::store;
+        const auto snapshot_path = PathOf("snapshot");
+        std::uint64_t snapshot_generation = 0;
+        if (File::Exists(snapshot_path)) {
+            const auto contents = File(snapshot_path, O_RDONLY).ReadAll();
+            if (contents.size() < store::SnapshotHeaderSize ||
+                contents.compare(0, store::MagicSize, store::SnapshotMagic) !=
+                    0) {
+                throw InvalidBinaryException("Not a document store snapshot",
+                                             0);
+            }
+            const auto* header = contents.data() + store::MagicSize;
+            snapshot_generation = store::GetFixed(header, 8);
+            const auto size = store::GetFixed(header + 8, 8);
+            const auto crc = store::GetFixed(header + 16, 4);
+            const auto* body = contents.data() + store::SnapshotHeaderSize;
+            if (size != contents.size() - store::SnapshotHeaderSize ||
+                crc != store::Crc32(body, size)) {
+                throw InvalidBinaryException(
+                    "Document store snapshot is damaged",
+                    store::SnapshotHeaderSize);
+            }
+            root_ = DecodeBinary<DynamicType>(body, size);
+        }
+
+        const auto log_path = PathOf("log");
+        generation_ = snapshot_generation;
+        if (File::Exists(log_path)) {
+            File log(log_path, O_RDWR);
+            const auto contents = log.ReadAll();
+            if (contents.size() >= store::LogHeaderSize &&
+                contents.compare(0, store::MagicSize, store::LogMagic) == 0) {
+                const auto generation =
+                    store::GetFixed(contents.data() + store::MagicSize, 8);
+                if (generation > snapshot_generation) {
+                    throw InvalidBinaryException(
+                        "Document store log is newer than its snapshot",
+                        store::MagicSize);
+                }
+                // An older log was folded into the snapshot before a crash
+                // stopped it being replaced.
+                if (generation == snapshot_generation) {
+                    const auto end = Replay(contents);
+                    if (end != contents.size()) {
+                        log.Truncate(end);
+                        log.Sync();
+                    }
+                    stats_.log_bytes = end;
+                    log_ = File(log_path, O_WRONLY | O_APPEND);
+                    return;
+                }
+            }
+        }
+        StartLog();
+    }
+
+    // Applies the records of a log, and returns the offset of the end of the
+    // last intact one.
+    std::size_t Replay(const std::string& contents) {
+        namespace store = detail::store;
+        std::size_t offset = store::LogHeaderSize;
+        while (contents.size() - offset >= store::RecordHeaderSize) {
+            const auto* header = contents.data() + offset;
+            const auto size = store::GetFixed(header, 4);
+            const auto crc = store::GetFixed(header + 4, 4);
+            const auto* body = header + store::RecordHeaderSize;
+            if (size > contents.size() - offset - store::RecordHeaderSize ||
+                crc != store::Crc32(body, size)) {
+                break;
+            }
+            detail::binary::Reader reader(body, body + size);
+            const auto operation = static_cast<Operation>(reader.Byte());
+            const auto path = store::GetPath(reader);
+            detail::binary::DecodeContext context;
+            context.reference_budget = detail::binary::ReferenceBudget(size);
+            auto value =
+                operation == Operation::Erase
+                    ? DynamicType()
+                    : detail::binary::DecodeDocument<DynamicType>(reader,
+                                                                  context);
+            store::Apply(root_, operation, path, std::move(value));
+            offset += store::RecordHeaderSize + size;
+        }
+        return offset;
+    }
+
+    // Replaces the log with an empty one of the current generation.
+    void StartLog() {
+        std::string header(detail::store::LogMagic,
+                           detail::store::MagicSize);
+        detail::binary::PutFixed64(header, generation_);
+        File::Replace(directory_, PathOf("log"), header);
+        log_ = File(PathOf("log"), O_WRONLY | O_APPEND);
+        stats_.log_bytes = header.size();
+    }
+
+    void WriteSnapshot() {
+        namespace store = detail::store;
+        std::string body;
+        EncodeBinary(root_, body, StringEncoding::Dictionary);
+        std::string contents(store::SnapshotMagic, store::MagicSize);
+        detail::binary::PutFixed64(contents, generation_ + 1);
+        detail::binary::PutFixed64(contents, body.size());
+        store::PutFixed32(contents, store::Crc32(body.data(), body.size()));
+        contents += body;
+        const auto path = PathOf("snapshot");
+        const auto temporary = File::Prepare(path, contents);
+        try {
+            File::Install(directory_, temporary, path);
+            ++generation_;
+            StartLog();
+        } catch (...) {
+            // Recovery skips a log older than the snapshot, so anything
+            // still appended to log_ would be lost.
+            failed_ = true;
+            committed_.notify_all();
+            throw;
+        }
+        ++stats_.snapshots;
+        // The snapshot holds the changes still waiting to be written.
+        pending_.clear();
+        durable_ = appended_;
+        committed_.notify_all();
+    }
+
+    void Change(const Operation operation, const DocumentPath& path,
+                DynamicType&& value) {
+        namespace store = detail::store;
+        // The value ends up path.size() levels down (one more when pushed),
+        // and a snapshot holding anything deeper could not be reopened.
+        if (operation != Operation::Erase) {
+            detail::binary::CheckDepth(
+                value,
+                path.size() + (operation == Operation::Push ? 1 : 0));
+        }
+        std::string record(store::RecordHeaderSize, '\0');
+        record.push_back(static_cast<char>(operation));
+        store::PutPath(record, path);
+        if (operation != Operation::Erase) {
+            EncodeBinary(value, record);
+        }
+        const auto size = record.size() - store::RecordHeaderSize;
+        const auto crc =
+            store::Crc32(record.data() + store::RecordHeaderSize, size);
+        for (int i = 0; i < 4; ++i) {
+            record[i] = static_cast<char>(size >> (8 * i));
+            record[4 + i] = static_cast<char>(crc >> (8 * i));
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        CheckLog();
+        // Applied before it is logged, so that a change that fails is never
+        // logged; once logged, it is replayed.
+        store::Apply(root_, operation, path, std::move(value));
+        pending_ += record;
+        const auto sequence = ++appended_;
+        ++stats_.records;
+        while (durable_ < sequence) {
+            CheckLog();
+            if (committing_) {
+                committed_.wait(lock);
+                continue;
+            }
+            Commit(lock);
+        }
+        if (options_.snapshot_log_bytes != 0 &&
+            stats_.log_bytes > options_.snapshot_log_bytes && !committing_) {
+            // The change is durable already, so a failed snapshot is not its
+            // failure: either the log is still good and the next change
+            // tries again, or failed_ refuses further changes.
+            try {
+                WriteSnapshot();
+            } catch (...) {
+            }
+        }
+    }
+
+    void CheckLog() const {
+        if (failed_) {
+            throw std::runtime_error(
+                "Document store log failed; reopen the store");
+        }
+    }
+
+    // Writes every pending record, with the lock released meanwhile.
+    void Commit(std::unique_lock<std::mutex>& lock) {
+        std::string batch;
+        batch.swap(pending_);
+        const auto target = appended_;
+        committing_ = true;
+        lock.unlock();
+        try {
+            log_.WriteAll(batch.data(), batch.size());
+            if (options_.sync) {
+                log_.Sync();
+            }
+        } catch (...) {
+            // The log may now end in part of a record, after which nothing
+            // could be replayed.
+            lock.lock();
+            committing_ = false;
+            failed_ = true;
+            committed_.notify_all();
+            throw;
+        }
+        lock.lock();
+        committing_ = false;
+        durable_ = target;
+        stats_.log_bytes += batch.size();
+        ++stats_.commits;
+        committed_.notify_all();
+    }
+
+    std::string directory_;
+    DocumentStoreOptions options_;
+    DynamicType root_;
+    File log_;
+    std::uint64_t generation_ = 0;
+    DocumentStoreStats stats_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable committed_;
+    // Records applied to root_ but not yet written, and how many records
+    // have been applied and made durable in all.
+    std::string pending_;
+    std::uint64_t appended_ = 0;
+    std::uint64_t durable_ = 0;
+    bool committing_ = false;
+    bool failed_ = false;
+};
+#endif
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_DOCUMENT_STORE_H
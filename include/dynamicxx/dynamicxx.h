@@ -17,9 +17,11 @@
 #ifndef DYNAMICXX_DYNAMICXX_H
 #define DYNAMICXX_DYNAMICXX_H
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -95,6 +97,61 @@ using DynamicxxMap = std::unordered_map<Ts...>;
 #include <concepts>
 #endif
 
+#ifndef DYNAMICXX_EXTERN_TEMPLATES
+#define DYNAMICXX_EXTERN_TEMPLATES 0
+#endif
+
+#ifndef DYNAMICXX_INSTRUMENT
+#define DYNAMICXX_INSTRUMENT 0
+#endif
+
+#if DYNAMICXX_INSTRUMENT
+#include "dynamicxx/instrument.h"
+#endif
+
+#ifndef DYNAMICXX_TRACE
+#define DYNAMICXX_TRACE 0
+#endif
+
+#if DYNAMICXX_TRACE || defined(DYNAMICXX_TRACE_HOOK)
+#include "dynamicxx/trace.h"
+#ifndef DYNAMICXX_TRACE_HOOK
+#define DYNAMICXX_TRACE_HOOK(event, address, size) \
+    ::dynamicxx::trace::Emit(event, address, size)
+#endif
+#define DTRACING 1
+#define DTRACE(event, address, size)                        \
+    DYNAMICXX_TRACE_HOOK(::dynamicxx::TraceEvent::event,    \
+                         static_cast<const void*>(address), \
+                         static_cast<std::size_t>(size))
+// Reports `event` for the subtree of `impl` if it is large. Only the outermost
+// copy or destruction in progress on a thread measures its subtree, so nested
+// values are not walked again for each level.
+#define DTRACE_LARGE(event, address, impl)                                   \
+    const ::dynamicxx::detail::NestedTrace dtrace_nested_;                  \
+    if (dtrace_nested_.Outermost()) {                                        \
+        const auto dtrace_size_ = (impl).LargeSubtreeTraceSize();            \
+        if (dtrace_size_ != 0) {                                             \
+            DTRACE(event, address, dtrace_size_);                            \
+        }                                                                    \
+    }
+#define DTRACE_GROWTH(container, address)                          \
+    const ::dynamicxx::detail::GrowthTrace<                        \
+        typename std::remove_reference<decltype(container)>::type> \
+        dtrace_growth_(container, address)
+#else
+#define DTRACING 0
+#define DTRACE(event, address, size) \
+    do {                             \
+    } while (false)
+#define DTRACE_LARGE(event, address, impl) \
+    do {                                   \
+    } while (false)
+#define DTRACE_GROWTH(container, address) \
+    do {                                  \
+    } while (false)
+#endif
+
 #define DDO_ASSERT(...)      \
     do {                     \
         assert(__VA_ARGS__); \
@@ -164,6 +221,201 @@ struct Null {};
 
 struct Undefined {};
 
+// A borrowed, read-only range of contiguous elements. The referenced storage
+// must outlive the view.
+template <class Type>
+class ContiguousView {
+   public:
+    using value_type = Type;                // NOLINT
+    using const_iterator = const Type*;     // NOLINT
+    using iterator = const_iterator;        // NOLINT
+
+    constexpr ContiguousView() noexcept : data_(nullptr), size_(0) {}
+    constexpr ContiguousView(const Type* data, const std::size_t size) noexcept
+        : data_(data), size_(size) {}
+
+    DNODISCARD constexpr const Type* data() const noexcept { return data_; }
+    DNODISCARD constexpr std::size_t size() const noexcept { return size_; }
+    DNODISCARD constexpr bool empty() const noexcept { return size_ == 0; }
+    DNODISCARD constexpr const_iterator begin() const noexcept {
+        return data_;
+    }
+    DNODISCARD constexpr const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+    DNODISCARD constexpr const Type& operator[](
+        const std::size_t index) const noexcept {
+        return data_[index];
+    }
+
+    DNODISCARD DCONSTEXPR_14 bool Equals(
+        const ContiguousView& that) const noexcept {
+        if (size_ != that.size_) {
+            return false;
+        }
+        // Views of the same storage, as from a StringDictionary.
+        if (data_ == that.data_) {
+            return true;
+        }
+        for (std::size_t i = 0; i < size_; ++i) {
+            if (!(data_[i] == that.data_[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+   private:
+    const Type* data_;
+    std::size_t size_;
+};
+
+struct HasDataImpl {
+    template <class T>
+    static AlwaysTrueType<decltype(std::declval<const T&>().data()),
+                          decltype(std::declval<const T&>().size())>
+    test(void*);
+
+    template <class T>
+    static std::false_type test(...);
+};
+
+template <class T>
+constexpr bool HasData() noexcept {
+    return decltype(HasDataImpl::template test<T>(nullptr))::value;
+}
+
+struct HasChunksImpl {
+    template <class T>
+    static AlwaysTrueType<decltype(std::declval<const T&>().Chunks()),
+                          decltype(std::declval<const T&>().ChunkCount())>
+    test(void*);
+
+    template <class T>
+    static std::false_type test(...);
+};
+
+// String types made of chunks, such as Rope, have no const data(): reading
+// them from a const document walks the chunks instead of flattening them.
+template <class T>
+constexpr bool HasChunks() noexcept {
+    return decltype(HasChunksImpl::template test<T>(nullptr))::value;
+}
+
+// Calls `visit(data, size)` for each contiguous piece of `string`, in order.
+template <class String, class Visit,
+          typename std::enable_if<!HasChunks<String>(), int>::type = 0>
+void ForEachChunk(const String& string, Visit&& visit) {
+    visit(string.data(), string.size());
+}
+template <class String, class Visit,
+          typename std::enable_if<HasChunks<String>(), int>::type = 0>
+void ForEachChunk(const String& string, Visit&& visit) {
+    for (const auto chunk : string.Chunks()) {
+        visit(chunk.data(), chunk.size());
+    }
+}
+
+// Calls `visit(data, size)` with the whole of `string` at once. A string of
+// several chunks is copied into a temporary to do so.
+template <class String, class Visit,
+          typename std::enable_if<!HasChunks<String>(), int>::type = 0>
+auto WithContiguous(const String& string, Visit&& visit)
+    -> decltype(visit(string.data(), string.size())) {
+    return visit(string.data(), string.size());
+}
+template <class String, class Visit,
+          typename std::enable_if<HasChunks<String>(), int>::type = 0>
+auto WithContiguous(const String& string, Visit&& visit)
+    -> decltype(visit(std::declval<const typename String::value_type*>(),
+                      std::size_t())) {
+    using Char = typename String::value_type;
+    if (string.ChunkCount() > 1) {
+        std::basic_string<Char> text;
+        text.reserve(string.size());
+        ForEachChunk(string, [&text](const Char* data, const std::size_t size) {
+            text.append(data, size);
+        });
+        return visit(text.data(), text.size());
+    }
+    static const Char empty[1] = {};
+    const Char* data = empty;
+    std::size_t size = 0;
+    ForEachChunk(string, [&](const Char* chunk, const std::size_t count) {
+        data = chunk;
+        size = count;
+    });
+    return visit(data, size);
+}
+
+// Whether `string` holds exactly the `size` characters at `data`.
+template <class String, class Char>
+bool TextEquals(const String& string, const Char* data,
+                const std::size_t size) noexcept {
+    if (string.size() != size) {
+        return false;
+    }
+    bool equal = true;
+    std::size_t offset = 0;
+    ForEachChunk(string, [&](const Char* chunk, const std::size_t count) {
+        if (equal && !std::equal(chunk, chunk + count, data + offset)) {
+            equal = false;
+        }
+        offset += count;
+    });
+    return equal;
+}
+
+// The StringView and BlobView of a BasicDynamic. They are distinct types even
+// when the string and blob element types agree.
+template <class Char>
+class StringView : public ContiguousView<Char> {
+   public:
+    using ContiguousView<Char>::ContiguousView;
+
+    constexpr StringView() noexcept = default;
+    // From a null terminated string.
+    StringView(const Char* string) noexcept
+        : ContiguousView<Char>(string, std::char_traits<Char>::length(string)) {
+    }
+    // From any contiguous container of Char, such as a std::string.
+    template <class Container,
+              typename std::enable_if<HasData<Container>(), int>::type = 0>
+    StringView(const Container& container) noexcept
+        : ContiguousView<Char>(container.data(), container.size()) {}
+
+    DNODISCARD friend DCONSTEXPR_14 bool operator==(
+        const StringView& lhs, const StringView& rhs) noexcept {
+        return lhs.Equals(rhs);
+    }
+    DNODISCARD friend DCONSTEXPR_14 bool operator!=(
+        const StringView& lhs, const StringView& rhs) noexcept {
+        return !lhs.Equals(rhs);
+    }
+};
+
+template <class Byte>
+class BlobView : public ContiguousView<Byte> {
+   public:
+    using ContiguousView<Byte>::ContiguousView;
+
+    constexpr BlobView() noexcept = default;
+    // From any contiguous container of Byte, such as a std::vector.
+    template <class Container,
+              typename std::enable_if<HasData<Container>(), int>::type = 0>
+    BlobView(const Container& container) noexcept
+        : ContiguousView<Byte>(container.data(), container.size()) {}
+
+    DNODISCARD friend DCONSTEXPR_14 bool operator==(
+        const BlobView& lhs, const BlobView& rhs) noexcept {
+        return lhs.Equals(rhs);
+    }
+    DNODISCARD friend DCONSTEXPR_14 bool operator!=(
+        const BlobView& lhs, const BlobView& rhs) noexcept {
+        return !lhs.Equals(rhs);
+    }
+};
+
 template <class Type>
 using Just = Type;
 
@@ -192,6 +444,18 @@ struct DefaultFactory {
         return Type{std::forward<Args>(args)...};
     }
 };
+#if DYNAMICXX_INSTRUMENT
+template <class Type>
+struct DefaultFactory<std::shared_ptr<Type>> {
+    using Allocator = CountingAllocator<Type, AllocationKind::Impl>;
+
+    template <class... Args>
+    std::shared_ptr<Type> operator()(Args&&... args) const {
+        return std::allocate_shared<Type>(Allocator{},
+                                          std::forward<Args>(args)...);
+    }
+};
+#else
 template <class Type>
 struct DefaultFactory<std::shared_ptr<Type>> {
     template <class... Args>
@@ -200,6 +464,7 @@ struct DefaultFactory<std::shared_ptr<Type>> {
         return std::make_shared<Type>(std::forward<Args>(args)...);
     }
 };
+#endif
 template <class Type>
 struct DefaultFactory<std::unique_ptr<Type>> {
     template <class... Args>
@@ -214,27 +479,324 @@ Type DefaultOf() noexcept(noexcept(DefaultFactory<Type>{}())) {
     return DefaultFactory<Type>{}();
 }
 
+template <class Type>
+std::size_t UseCount(const Type&) noexcept {
+    return 1;
+}
+template <class Type>
+std::size_t UseCount(const std::shared_ptr<Type>& ptr) noexcept {
+    return static_cast<std::size_t>(ptr.use_count());
+}
+
+namespace memory {
+
+// Heap bytes a wrapper needs for the Impl it owns, beyond its own size.
+template <class Wrapper>
+struct WrapperHeapBytes : std::integral_constant<std::size_t, 0> {};
+
+// Estimated as the object plus a control block of a vtable pointer and two
+// reference counts, as allocated by std::make_shared.
+template <class Type>
+struct WrapperHeapBytes<std::shared_ptr<Type>>
+    : std::integral_constant<std::size_t,
+                             sizeof(Type) + sizeof(void*) + 2 * sizeof(long)> {
+};
+
+struct HasCapacityImpl {
+    template <class T>
+    static AlwaysTrueType<decltype(std::declval<const T&>().capacity())> test(
+        void*);
+
+    template <class T>
+    static std::false_type test(...);
+};
+
+struct HasBucketCountImpl {
+    template <class T>
+    static AlwaysTrueType<decltype(std::declval<const T&>().bucket_count())>
+    test(void*);
+
+    template <class T>
+    static std::false_type test(...);
+};
+
+struct HasKeysImpl {
+    template <class T>
+    static AlwaysTrueType<decltype(std::declval<const T&>().keys()),
+                          decltype(std::declval<const T&>().values())>
+    test(void*);
+
+    template <class T>
+    static std::false_type test(...);
+};
+
+struct HasIndexBytesImpl {
+    template <class T>
+    static AlwaysTrueType<decltype(std::declval<const T&>().index_bytes())>
+    test(void*);
+
+    template <class T>
+    static std::false_type test(...);
+};
+
+struct HasHeapBytesImpl {
+    template <class T>
+    static AlwaysTrueType<decltype(std::declval<const T&>().HeapBytes())> test(
+        void*);
+
+    template <class T>
+    static std::false_type test(...);
+};
+
+template <class T>
+constexpr bool HasCapacity() noexcept {
+    return decltype(HasCapacityImpl::template test<T>(nullptr))::value;
+}
+
+template <class T>
+constexpr bool HasBucketCount() noexcept {
+    return decltype(HasBucketCountImpl::template test<T>(nullptr))::value;
+}
+
+template <class T>
+constexpr bool HasKeys() noexcept {
+    return decltype(HasKeysImpl::template test<T>(nullptr))::value;
+}
+
+template <class T>
+constexpr bool HasIndexBytes() noexcept {
+    return decltype(HasIndexBytesImpl::template test<T>(nullptr))::value;
+}
+
+template <class T>
+constexpr bool HasHeapBytes() noexcept {
+    return decltype(HasHeapBytesImpl::template test<T>(nullptr))::value;
+}
+
+template <bool>
+struct Capacity;
+
+template <>
+struct Capacity<true> {
+    template <class T>
+    std::size_t operator()(const T& container) const noexcept {
+        return container.capacity();
+    }
+};
+template <>
+struct Capacity<false> {
+    template <class T>
+    std::size_t operator()(const T& container) const noexcept {
+        return container.size();
+    }
+};
+
+template <class T>
+std::size_t CapacityOf(const T& container) noexcept {
+    return Capacity<HasCapacity<T>()>{}(container);
+}
+
+// Heap bytes of an Integer or Number policy, reported by a HeapBytes() member,
+// such as the spilled limbs of a BigInteger. Built-in arithmetic types have
+// none.
+template <class T,
+          typename std::enable_if<HasHeapBytes<T>(), int>::type = 0>
+std::size_t HeapBytesOf(const T& value) noexcept {
+    return value.HeapBytes();
+}
+template <class T,
+          typename std::enable_if<!HasHeapBytes<T>(), int>::type = 0>
+std::size_t HeapBytesOf(const T&) noexcept {
+    return 0;
+}
+
+// Bytes a string keeps on the heap; nothing while it fits in the inline
+// (small string) buffer.
+template <class String>
+std::size_t StringHeapBytes(const String& string) {
+    using Char = typename String::value_type;
+    static const std::size_t InlineCapacity = CapacityOf(String());
+
+    const auto capacity = CapacityOf(string);
+    if (capacity <= InlineCapacity) {
+        return 0;
+    }
+    return (capacity + 1) * sizeof(Char);
+}
+
+// Bytes of a sequence's storage that are allocated but unused.
+template <class Sequence>
+std::size_t SequenceSlackBytes(const Sequence& sequence) noexcept {
+    using Value = typename Sequence::value_type;
+    return (CapacityOf(sequence) - sequence.size()) * sizeof(Value);
+}
+
+template <int>
+struct MapOverhead;
+
+// Hash tables: the bucket array, plus a next pointer and a cached hash per
+// node. The node layout is an estimate that matches the common
+// implementations.
+template <>
+struct MapOverhead<0> {
+    template <class Map>
+    std::size_t operator()(const Map& map) const noexcept {
+        return map.bucket_count() * sizeof(void*) +
+               map.size() * (sizeof(void*) + sizeof(std::size_t));
+    }
+};
+// Flat maps: the unused capacity of the key and value containers.
+template <>
+struct MapOverhead<1> {
+    template <class Map>
+    std::size_t operator()(const Map& map) const noexcept {
+        return SequenceSlackBytes(map.keys()) +
+               SequenceSlackBytes(map.values());
+    }
+};
+// Anything else is assumed to have no overhead worth estimating.
+template <>
+struct MapOverhead<2> {
+    template <class Map>
+    std::size_t operator()(const Map&) const noexcept {
+        return 0;
+    }
+};
+// Dense entries with a separate index, such as OrderedMap: the unused entry
+// capacity and the index.
+template <>
+struct MapOverhead<3> {
+    template <class Map>
+    std::size_t operator()(const Map& map) const noexcept {
+        return SequenceSlackBytes(map) + map.index_bytes();
+    }
+};
+
+template <class Map>
+std::size_t MapOverheadBytes(const Map& map) noexcept {
+    return MapOverhead<HasIndexBytes<Map>()    ? 3
+                       : HasBucketCount<Map>() ? 0
+                       : HasKeys<Map>()        ? 1
+                                               : 2>{}(map);
+}
+
+template <int>
+struct StorageMarker;
+
+template <>
+struct StorageMarker<0> {
+    template <class Container>
+    std::size_t operator()(const Container& container) const noexcept {
+        return container.bucket_count();
+    }
+};
+template <>
+struct StorageMarker<1> {
+    template <class Container>
+    std::size_t operator()(const Container& container) const noexcept {
+        return CapacityOf(container.keys());
+    }
+};
+template <>
+struct StorageMarker<2> {
+    template <class Container>
+    std::size_t operator()(const Container& container) const noexcept {
+        return CapacityOf(container);
+    }
+};
+
+// A value that changes whenever the container reallocates its storage.
+template <class Container>
+std::size_t StorageMarkerOf(const Container& container) noexcept {
+    return StorageMarker<HasBucketCount<Container>() ? 0
+                         : HasKeys<Container>()      ? 1
+                                                     : 2>{}(container);
+}
+
+}  // namespace memory
+
+#if DTRACING
+// Counts the copies and destructions in progress on this thread, which nest
+// as a document is copied or destroyed value by value.
+class NestedTrace {
+   public:
+    NestedTrace() noexcept : outermost_(Depth()++ == 0) {}
+    ~NestedTrace() { --Depth(); }
+
+    NestedTrace(const NestedTrace&) = delete;
+    NestedTrace& operator=(const NestedTrace&) = delete;
+
+    DNODISCARD bool Outermost() const noexcept { return outermost_; }
+
+   private:
+    static std::size_t& Depth() noexcept {
+        static thread_local std::size_t depth = 0;
+        return depth;
+    }
+
+    bool outermost_;
+};
+
+// Reports a Growth event if the container reallocated during its scope.
+template <class Container>
+class GrowthTrace {
+   public:
+    GrowthTrace(const Container& container, const void* address) noexcept
+        : container_(container),
+          address_(address),
+          marker_(memory::StorageMarkerOf(container)) {}
+
+    ~GrowthTrace() {
+        if (memory::StorageMarkerOf(container_) != marker_) {
+            DTRACE(Growth, address_, container_.size());
+        }
+    }
+
+   private:
+    const Container& container_;
+    const void* address_;
+    std::size_t marker_;
+};
+#endif
+
 class ConverstionError : std::runtime_error {
    public:
     using std::runtime_error::runtime_error;
 };
 
-constexpr std::size_t StoUsz(const char* str, const std::size_t length) {
-#if DHAS_CXX_23
-    [[assume(str != nullptr)]];
-    [[assume(length > 0)]];
-#endif
-    std::size_t v = 0;
-    for (std::size_t i = 0; i < length; ++i) {
-        const auto n = str[i];
-        if (n < '0' || n > '9') {
-            throw ConverstionError(
-                "Invalid characters in conversion to std::size_t");
-        }
-        v *= 10;
-        v += (n - '0');
+DCONSTEXPR_14 bool IsDigit(const char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+// Eight characters as a little-endian word. Compilers turn this into a single
+// load, and unlike std::memcpy it is usable in constant expressions.
+DCONSTEXPR_14 std::uint64_t LoadEight(const char* str) noexcept {
+    std::uint64_t word = 0;
+    for (int i = 0; i < 8; ++i) {
+        word |= static_cast<std::uint64_t>(static_cast<unsigned char>(str[i]))
+                << (8 * i);
     }
-    return v;
+    return word;
+}
+
+// Whether all eight bytes of `word` are ASCII digits.
+DCONSTEXPR_14 bool IsEightDigits(const std::uint64_t word) noexcept {
+    return ((word & 0xF0F0F0F0F0F0F0F0U) |
+            (((word + 0x0606060606060606U) & 0xF0F0F0F0F0F0F0F0U) >> 4)) ==
+           0x3333333333333333U;
+}
+
+// The value of eight digits, in three multiplications rather than eight: the
+// digits are combined pairwise into bytes, then the pairs into 16-bit halves,
+// then the halves.
+DCONSTEXPR_14 std::uint32_t ParseEightDigits(std::uint64_t word) noexcept {
+    const std::uint64_t mask = 0x000000FF000000FFU;
+    const std::uint64_t high = 0x000F424000000064U;  // 1000000 and 100
+    const std::uint64_t low = 0x0000271000000001U;   // 10000 and 1
+    word -= 0x3030303030303030U;
+    word = (word * 10) + (word >> 8);
+    word = (((word & mask) * high) + (((word >> 16) & mask) * low)) >> 32;
+    return static_cast<std::uint32_t>(word);
 }
 
 constexpr std::size_t Strlen(const char* str) noexcept {
@@ -248,41 +810,223 @@ constexpr std::size_t Strlen(const char* str) noexcept {
     return length;
 }
 
+// Longest decimal form of a 64-bit integer: 20 digits, or 19 and a sign.
+constexpr std::size_t MaxIntegerLength = 20;
+
+// "00" to "99", so that digits can be written two at a time.
+inline const char* DigitPairs() noexcept {
+    static const char pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233"
+        "34353637383940414243444546474849505152535455565758596061626364656667"
+        "6869707172737475767778798081828384858687888990919293949596979899";
+    return pairs;
+}
+
+inline std::size_t CountDigits(std::uint64_t value) noexcept {
+    std::size_t count = 1;
+    while (true) {
+        if (value < 10) {
+            return count;
+        }
+        if (value < 100) {
+            return count + 1;
+        }
+        if (value < 1000) {
+            return count + 2;
+        }
+        if (value < 10000) {
+            return count + 3;
+        }
+        value /= 10000;
+        count += 4;
+    }
+}
+
+// Writes `value` in decimal to `out`, which must have room for
+// MaxIntegerLength characters, and returns the end. There is no terminator.
+inline char* FormatInteger(char* out, std::uint64_t value,
+                           std::false_type /*is_signed*/) noexcept {
+    const char* pairs = DigitPairs();
+    char* const end = out + CountDigits(value);
+    char* str = end;
+    while (value >= 100) {
+        const auto pair = static_cast<std::size_t>(value % 100) * 2;
+        value /= 100;
+        *--str = pairs[pair + 1];
+        *--str = pairs[pair];
+    }
+    if (value >= 10) {
+        const auto pair = static_cast<std::size_t>(value) * 2;
+        *--str = pairs[pair + 1];
+        *--str = pairs[pair];
+    } else {
+        *--str = static_cast<char>('0' + value);
+    }
+    return end;
+}
+inline char* FormatInteger(char* out, const std::int64_t value,
+                           std::true_type /*is_signed*/) noexcept {
+    auto magnitude = static_cast<std::uint64_t>(value);
+    if (value < 0) {
+        *out++ = '-';
+        magnitude = 0 - magnitude;
+    }
+    return FormatInteger(out, magnitude, std::false_type{});
+}
+template <class Type>
+char* FormatInteger(char* out, const Type value) noexcept {
+    static_assert(std::is_integral<Type>::value, "Only integers are formatted");
+    return FormatInteger(out, value, std::is_signed<Type>{});
+}
+
 }  // namespace detail
 
+// Why a numeric parser stopped, for callers that cannot afford exceptions.
+enum struct ParseError : std::uint8_t {
+    None = 0,
+    // No digits where a number was expected.
+    Empty,
+    InvalidCharacter,
+    // The value does not fit in the requested type.
+    Overflow,
+};
+
+// As for std::from_chars, `end` is one past the last character of the number,
+// and parsing stops at the first character that cannot continue it.
+struct ParseResult {
+    const char* end;
+    ParseError error;
+};
+
+// Parses the decimal digits at the start of [first, last), eight at a time.
+// On overflow, the digits are still consumed and `value` is left unchanged.
+DCONSTEXPR_14 ParseResult ParseInteger(const char* first, const char* last,
+                                       std::uint64_t& value) noexcept {
+    const char* str = first;
+    while (str != last && *str == '0') {
+        ++str;
+    }
+    const char* const significant = str;
+    std::uint64_t result = 0;
+    while (last - str >= 8 && detail::IsEightDigits(detail::LoadEight(str))) {
+        result = result * 100000000 +
+                 detail::ParseEightDigits(detail::LoadEight(str));
+        str += 8;
+    }
+    while (str != last && detail::IsDigit(*str)) {
+        result = result * 10 + static_cast<std::uint64_t>(*str - '0');
+        ++str;
+    }
+    if (str == first) {
+        return ParseResult{first, ParseError::Empty};
+    }
+    // Up to 19 digits always fit. Twenty fit only if the value, which wraps
+    // around when it does not, starts with a 1 and is at least 10^19.
+    const auto digits = str - significant;
+    if (digits > 20 ||
+        (digits == 20 &&
+         (*significant != '1' || result < 10000000000000000000U))) {
+        return ParseResult{str, ParseError::Overflow};
+    }
+    value = result;
+    return ParseResult{str, ParseError::None};
+}
+
+// As above, with an optional leading '-'.
+DCONSTEXPR_14 ParseResult ParseInteger(const char* first, const char* last,
+                                       std::int64_t& value) noexcept {
+    const bool negative = first != last && *first == '-';
+    std::uint64_t magnitude = 0;
+    const auto result =
+        ParseInteger(first + (negative ? 1 : 0), last, magnitude);
+    if (result.error != ParseError::None) {
+        return ParseResult{result.error == ParseError::Empty ? first
+                                                             : result.end,
+                           result.error};
+    }
+    const auto max = static_cast<std::uint64_t>(INT64_MAX);
+    if (magnitude > max + (negative ? 1 : 0)) {
+        return ParseResult{result.end, ParseError::Overflow};
+    }
+    value = negative ? static_cast<std::int64_t>(0 - magnitude)
+                     : static_cast<std::int64_t>(magnitude);
+    return result;
+}
+
 struct DefaultToIndex {
     template <class Type>
     constexpr std::size_t Convert(Type value) const noexcept {
         return static_cast<std::size_t>(value);
     }
 
-    constexpr std::size_t Convert(const char* str,
-                                  const std::size_t length) const {
-        return detail::StoUsz(str, length);
+    DCONSTEXPR_14 std::size_t Convert(const char* str,
+                                      const std::size_t length) const {
+        std::size_t index = 0;
+        switch (TryConvert(str, length, index)) {
+            case ParseError::None:
+                return index;
+            case ParseError::Overflow:
+                throw detail::ConverstionError(
+                    "Index out of range in conversion to std::size_t");
+            default:
+                throw detail::ConverstionError(
+                    "Invalid characters in conversion to std::size_t");
+        }
     }
 
-    constexpr std::size_t Convert(const char* str) const {
+    DCONSTEXPR_14 std::size_t Convert(const char* str) const {
         return Convert(str, detail::Strlen(str));
     }
 
-    constexpr std::size_t Convert(const std::string& str) const {
-        return detail::StoUsz(str.c_str(), str.length());
+    DCONSTEXPR_14 std::size_t Convert(const std::string& str) const {
+        return Convert(str.c_str(), str.length());
+    }
+
+    // Non-throwing: `index` is only written on success.
+    DCONSTEXPR_14 ParseError TryConvert(const char* str,
+                                        const std::size_t length,
+                                        std::size_t& index) const noexcept {
+        std::uint64_t value = 0;
+        const auto result = ParseInteger(str, str + length, value);
+        if (result.error != ParseError::None) {
+            return result.error;
+        }
+        if (result.end != str + length) {
+            return ParseError::InvalidCharacter;
+        }
+        if (value > static_cast<std::uint64_t>(~std::size_t{0})) {
+            return ParseError::Overflow;
+        }
+        index = static_cast<std::size_t>(value);
+        return ParseError::None;
     }
 };
 
+// Integers are formatted into a stack buffer, and from there straight into the
+// string, which for short keys is its inline storage.
 template <class String>
-struct IntStringifier;
-
-template <>
-struct IntStringifier<std::string> {
-    template <class Type>
-    std::string Convert(Type value) const {
-        return std::to_string(value);
+struct IntStringifier {
+    template <class Type, typename std::enable_if<std::is_integral<Type>::value,
+                                                  int>::type = 0>
+    String Convert(const Type value) const {
+        char buffer[detail::MaxIntegerLength];
+        const char* end = detail::FormatInteger(buffer, value);
+        return String(buffer, static_cast<std::size_t>(end - buffer));
+    }
+
+    template <class Type,
+              typename std::enable_if<std::is_floating_point<Type>::value,
+                                      int>::type = 0>
+    String Convert(const Type value) const {
+        const auto text = std::to_string(value);
+        return String(text.data(), text.size());
     }
 };
 
 struct DefaultToString {
-    template <class String, class Type>
+    template <class String, class Type,
+              typename std::enable_if<std::is_arithmetic<Type>::value,
+                                      int>::type = 0>
     String Convert(Type value) const {
         return IntStringifier<String>{}.Convert(value);
     }
@@ -298,20 +1042,171 @@ struct DefaultToString {
     }
 };
 
+// Deep memory footprint of a document, as returned by
+// BasicDynamic::MemoryUsage(). Heap sizes of the standard containers are not
+// observable, so node and bucket sizes of hash tables are estimates.
+struct MemoryFootprint {
+    // The values themselves: the root, and every array element and object
+    // value, whether it lives in its parent's storage or not.
+    std::size_t inline_bytes = 0;
+    // Heap storage of Integer and Number payloads, such as BigInteger limbs.
+    std::size_t number_bytes = 0;
+    // Heap storage of String payloads that do not fit the inline buffer.
+    std::size_t string_bytes = 0;
+    // Bytes held by Blob payloads.
+    std::size_t blob_bytes = 0;
+    // Object keys, including their heap storage.
+    std::size_t key_bytes = 0;
+    // Unused vector capacity, hash table buckets and node links.
+    std::size_t container_overhead = 0;
+    // Heap allocated Impls (and their control blocks) of managed values.
+    std::size_t managed_bytes = 0;
+
+    // For managed values, the bytes reachable only through this document,
+    // and those also referenced from elsewhere (by another copy of a handle).
+    // Together they add up to Total().
+    std::size_t exclusive_bytes = 0;
+    std::size_t shared_bytes = 0;
+
+    // Bytes referenced by StringView and BlobView payloads. They belong to
+    // another buffer, so are not part of Total().
+    std::size_t borrowed_bytes = 0;
+
+    DNODISCARD std::size_t Total() const noexcept {
+        return inline_bytes + number_bytes + string_bytes + blob_bytes +
+               key_bytes + container_overhead + managed_bytes;
+    }
+};
+
 class InvalidAccessException : std::runtime_error {
    public:
     using std::runtime_error::runtime_error;
 };
 
+// What BasicDynamic::FromPairs() and ObjectBuilder do with repeated keys.
+enum struct DuplicateKeys : std::uint8_t {
+    // The last value given for a key wins, as with repeated assignment.
+    KeepLast = 0,
+    KeepFirst,
+    // Throw std::invalid_argument.
+    Throw,
+};
+
+namespace detail {
+
+template <class Object>
+struct IsStdFlatMap : std::false_type {};
+#if __cpp_lib_flat_map >= 202207L
+template <class... Ts>
+struct IsStdFlatMap<std::flat_map<Ts...>> : std::true_type {};
+#endif
+
+[[noreturn]] inline void ThrowDuplicateKey(const std::string& key) {
+    throw std::invalid_argument("Duplicate object key: " + key);
+}
+
+// Builds an object from a batch of entries, which are left moved from.
+template <bool>
+struct AssembleObject;
+
+// Hash tables and other containers: one insertion per entry, into storage
+// reserved up front.
+template <>
+struct AssembleObject<false> {
+    template <class Object, class Entry>
+    void operator()(Object& object, std::vector<Entry>& entries,
+                    const DuplicateKeys duplicates) const {
+        reserve(object, entries.size());
+        for (auto& entry : entries) {
+            const auto it = object.find(entry.first);
+            if (it == object.end()) {
+                object.emplace(std::move(entry.first),
+                               std::move(entry.second));
+            } else if (duplicates == DuplicateKeys::KeepLast) {
+                it->second = std::move(entry.second);
+            } else if (duplicates == DuplicateKeys::Throw) {
+                ThrowDuplicateKey(entry.first);
+            }
+        }
+    }
+};
+
+#if __cpp_lib_flat_map >= 202207L
+// std::flat_map: sort once, and hand the map its keys and values already
+// sorted, instead of shifting both containers on every insertion.
+template <>
+struct AssembleObject<true> {
+    template <class Object, class Entry>
+    void operator()(Object& object, std::vector<Entry>& entries,
+                    const DuplicateKeys duplicates) const {
+        const auto less = object.key_comp();
+        // Stable, so that the entries for a key stay in the order given.
+        std::stable_sort(entries.begin(), entries.end(),
+                         [&less](const Entry& lhs, const Entry& rhs) {
+                             return less(lhs.first, rhs.first);
+                         });
+        typename Object::key_container_type keys;
+        typename Object::mapped_container_type values;
+        reserve(keys, entries.size());
+        reserve(values, entries.size());
+        for (auto first = entries.begin(); first != entries.end();) {
+            auto last = first + 1;
+            while (last != entries.end() && !less(first->first, last->first)) {
+                ++last;
+            }
+            if (last - first > 1 && duplicates == DuplicateKeys::Throw) {
+                ThrowDuplicateKey(first->first);
+            }
+            auto& entry =
+                duplicates == DuplicateKeys::KeepLast ? *(last - 1) : *first;
+            keys.push_back(std::move(entry.first));
+            values.push_back(std::move(entry.second));
+            first = last;
+        }
+        object = Object(std::sorted_unique, std::move(keys), std::move(values));
+    }
+};
+#endif
+
+// The number of elements in [first, last), if that can be known without
+// consuming them.
+template <class Iterator>
+std::size_t RangeSize(Iterator first, Iterator last,
+                      std::forward_iterator_tag /*category*/) {
+    return static_cast<std::size_t>(std::distance(first, last));
+}
+template <class Iterator>
+std::size_t RangeSize(Iterator, Iterator, std::input_iterator_tag) noexcept {
+    return 0;
+}
+
+}  // namespace detail
+
+// Whether a type can be the IntegerType or NumberType of a BasicDynamic.
+// Specialize them to use class types, as bignum.h does.
+template <class Type>
+struct IsIntegerPolicy : std::is_integral<Type> {};
+template <class Type>
+struct IsNumberPolicy : std::is_floating_point<Type> {};
+
 using DefaultInteger = std::int64_t;
 using DefaultNumber = double;
 using DefaultString = std::string;
 template <class... Ts>
 using DefaultBlobContainer = std::vector<Ts...>;
+// String and Blob keep their standard types when instrumenting, so code that
+// compares them with std::string or std::vector keeps compiling.
+#if DYNAMICXX_INSTRUMENT
+template <class Type>
+using DefaultArrayContainer = InstrumentedArrayContainer<Type>;
+template <class Key, class Value>
+using DefaultObjectContainer = InstrumentedObjectContainer<Key, Value>;
+#else
 template <class... Ts>
 using DefaultArrayContainer = std::vector<Ts...>;
 template <class... Ts>
 using DefaultObjectContainer = DynamicxxMap<Ts...>;
+#endif
 
 template <class IntegerType = DefaultInteger, class NumberType = DefaultNumber,
           class StringType = DefaultString,
@@ -332,11 +1227,17 @@ class BasicDynamic {
     using Array = ArrayContainerType<BasicDynamic>;
     using Object = ObjectContainerType<std::string, BasicDynamic>;
     using Undefined = detail::Undefined;
-
-    static_assert(std::is_integral<Integer>::value,
-                  "Integer type provided must be an integral type");
-    static_assert(std::is_floating_point<Number>::value,
-                  "Number type provided must be a floating point type");
+    // Borrowed strings and blobs, such as those a parser points into its
+    // input buffer. Materialize() replaces them with owned copies.
+    using StringView = detail::StringView<typename String::value_type>;
+    using BlobView = detail::BlobView<typename Blob::value_type>;
+
+    static_assert(IsIntegerPolicy<Integer>::value,
+                  "Integer type provided must be an integral type, or "
+                  "have IsIntegerPolicy specialized");
+    static_assert(IsNumberPolicy<Number>::value,
+                  "Number type provided must be a floating point type, or "
+                  "have IsNumberPolicy specialized");
 
     template <class... Args>
     struct BestFitFor;
@@ -355,6 +1256,10 @@ class BasicDynamic {
     struct BestFitFor<Array> : detail::TypeIdentity<Array> {};
     template <>
     struct BestFitFor<Object> : detail::TypeIdentity<Object> {};
+    template <>
+    struct BestFitFor<StringView> : detail::TypeIdentity<StringView> {};
+    template <>
+    struct BestFitFor<BlobView> : detail::TypeIdentity<BlobView> {};
 
 #if DHAS_CONCEPTS
     template <class Type>
@@ -424,6 +1329,8 @@ class BasicDynamic {
         Blob,
         Array,
         Object,
+        StringView,
+        BlobView,
         Undefined = ~static_cast<TagRepr>(0),
     };
 
@@ -450,6 +1357,10 @@ class BasicDynamic {
     template <>
     struct TagOfHelper<Object> : TagIdentity<Tag::Object> {};
     template <>
+    struct TagOfHelper<StringView> : TagIdentity<Tag::StringView> {};
+    template <>
+    struct TagOfHelper<BlobView> : TagIdentity<Tag::BlobView> {};
+    template <>
     struct TagOfHelper<Undefined> : TagIdentity<Tag::Undefined> {};
 
     template <class Type>
@@ -469,6 +1380,8 @@ class BasicDynamic {
         Blob blob;
         Array array;
         Object object;
+        StringView string_view;
+        BlobView blob_view;
         Undefined undefined = {};
     };
 
@@ -516,6 +1429,12 @@ class BasicDynamic {
         DNODISCARD constexpr bool HoldsObject() const noexcept {
             return Holds<Object>();
         }
+        DNODISCARD constexpr bool HoldsStringView() const noexcept {
+            return Holds<StringView>();
+        }
+        DNODISCARD constexpr bool HoldsBlobView() const noexcept {
+            return Holds<BlobView>();
+        }
         DNODISCARD constexpr bool HoldsUndefined() const noexcept {
             return Holds<Undefined>();
         }
@@ -604,6 +1523,22 @@ class BasicDynamic {
             }
         }
 
+        DNODISCARD DCONSTEXPR_14 StringView GetStringView() const {
+            if (HoldsStringView()) {
+                LIKELY { return payload_.string_view; }
+            } else {
+                UNLIKELY { InvalidAccess(); }
+            }
+        }
+
+        DNODISCARD DCONSTEXPR_14 BlobView GetBlobView() const {
+            if (HoldsBlobView()) {
+                LIKELY { return payload_.blob_view; }
+            } else {
+                UNLIKELY { InvalidAccess(); }
+            }
+        }
+
         DNODISCARD DCONSTEXPR_14 Null GetNull() const {
             if (HoldsNull()) {
                 LIKELY { return payload_.null; }
@@ -612,6 +1547,14 @@ class BasicDynamic {
             }
         }
 
+        DNODISCARD DCONSTEXPR_14 Undefined GetUndefined() const {
+            if (HoldsUndefined()) {
+                LIKELY { return payload_.undefined; }
+            } else {
+                UNLIKELY { InvalidAccess(); }
+            }
+        }
+
         void Move(Impl& that) noexcept {
             DestroyIfNeeded();
             MoveRaw(that);
@@ -639,6 +1582,8 @@ class BasicDynamic {
         friend Caster<Blob>;
         friend Caster<Array>;
         friend Caster<Object>;
+        friend Caster<StringView>;
+        friend Caster<BlobView>;
 
         template <>
         struct Caster<Boolean> {
@@ -704,6 +1649,26 @@ class BasicDynamic {
             }
         };
 
+        template <>
+        struct Caster<StringView> {
+            DNODISCARD static constexpr StringView& As(Impl& impl) {
+                return impl.payload_.string_view;
+            }
+            DNODISCARD static constexpr const StringView& As(
+                const Impl& impl) {
+                return impl.payload_.string_view;
+            }
+        };
+        template <>
+        struct Caster<BlobView> {
+            DNODISCARD static constexpr BlobView& As(Impl& impl) {
+                return impl.payload_.blob_view;
+            }
+            DNODISCARD static constexpr const BlobView& As(const Impl& impl) {
+                return impl.payload_.blob_view;
+            }
+        };
+
         template <>
         struct Caster<Null> {
             DNODISCARD static constexpr Null As(const Impl& impl) {
@@ -762,7 +1727,7 @@ class BasicDynamic {
                     auto& array = impl.As<Array>();
                     detail::reserve(array, payload_.array.size());
                     for (const auto& value : payload_.array) {
-                        array.emplace_back(value.Clone());
+                        array.emplace_back(value.CloneTree());
                     }
                     return impl;
                 }
@@ -771,10 +1736,18 @@ class BasicDynamic {
                     auto& object = impl.As<Object>();
                     detail::reserve(object, payload_.object.size());
                     for (const auto& value : payload_.object) {
-                        object[value.first] = value.second.Clone();
+                        object[value.first] = value.second.CloneTree();
                     }
                     return impl;
                 }
+                case Tag::StringView: {
+                    impl.EmplaceRaw<StringView>(payload_.string_view);
+                    return impl;
+                }
+                case Tag::BlobView: {
+                    impl.EmplaceRaw<BlobView>(payload_.blob_view);
+                    return impl;
+                }
                 case Tag::Undefined: {
                     impl.EmplaceRaw<Undefined>(payload_.undefined);
                     return impl;
@@ -812,6 +1785,12 @@ class BasicDynamic {
                 case Tag::Object: {
                     return payload_.object == that.payload_.object;
                 }
+                case Tag::StringView: {
+                    return payload_.string_view == that.payload_.string_view;
+                }
+                case Tag::BlobView: {
+                    return payload_.blob_view == that.payload_.blob_view;
+                }
                 case Tag::Undefined: {
                     return true;
                 }
@@ -865,6 +1844,14 @@ class BasicDynamic {
                     EmplaceRaw<Object>(std::move(that.payload_.object));
                     break;
                 }
+                case Tag::StringView: {
+                    EmplaceRaw<StringView>(that.payload_.string_view);
+                    break;
+                }
+                case Tag::BlobView: {
+                    EmplaceRaw<BlobView>(that.payload_.blob_view);
+                    break;
+                }
                 case Tag::Undefined: {
                     break;
                 }
@@ -876,6 +1863,7 @@ class BasicDynamic {
         }
 
         void CopyRaw(const Impl& that) noexcept {
+            DTRACE_LARGE(DeepCopy, this, that);
             tag_ = that.tag_;
             switch (that.tag_) {
                 case Tag::Null: {
@@ -909,6 +1897,14 @@ class BasicDynamic {
                     EmplaceRaw<Object>(that.payload_.object);
                     break;
                 }
+                case Tag::StringView: {
+                    EmplaceRaw<StringView>(that.payload_.string_view);
+                    break;
+                }
+                case Tag::BlobView: {
+                    EmplaceRaw<BlobView>(that.payload_.blob_view);
+                    break;
+                }
                 case Tag::Undefined: {
                     break;
                 }
@@ -923,6 +1919,7 @@ class BasicDynamic {
         }
 
         DCONSTEXPR_23 void DestroyIfNeeded() noexcept {
+            DTRACE_LARGE(Destroy, this, *this);
             switch (tag_) {
                 case Tag::Null: {
                     payload_.null.~Null();
@@ -956,6 +1953,14 @@ class BasicDynamic {
                     payload_.object.~Object();
                     break;
                 }
+                case Tag::StringView: {
+                    payload_.string_view.~StringView();
+                    break;
+                }
+                case Tag::BlobView: {
+                    payload_.blob_view.~BlobView();
+                    break;
+                }
                 case Tag::Undefined: {
                     payload_.undefined.~Undefined();
                     break;
@@ -967,6 +1972,59 @@ class BasicDynamic {
             tag_ = Tag::Undefined;
         }
 
+        // Length of strings and blobs, element count of arrays and objects.
+        DNODISCARD std::size_t TraceSize() const noexcept {
+            switch (tag_) {
+                case Tag::String:
+                    return payload_.string.size();
+                case Tag::Blob:
+                    return payload_.blob.size();
+                case Tag::Array:
+                    return payload_.array.size();
+                case Tag::Object:
+                    return payload_.object.size();
+                default:
+                    return 0;
+            }
+        }
+
+#if DTRACING
+        // TraceSize() summed over the subtree, or 0 if that is less than
+        // DYNAMICXX_TRACE_LARGE_SIZE. Only used by DTRACE_LARGE, so never
+        // evaluated when not tracing.
+        DNODISCARD std::size_t LargeSubtreeTraceSize() const noexcept {
+            if (SubtreeTraceSize(DYNAMICXX_TRACE_LARGE_SIZE) <
+                DYNAMICXX_TRACE_LARGE_SIZE) {
+                return 0;
+            }
+            return SubtreeTraceSize(static_cast<std::size_t>(-1));
+        }
+
+        // TraceSize() summed over the subtree, stopping once it reaches
+        // `limit`.
+        DNODISCARD std::size_t SubtreeTraceSize(
+            const std::size_t limit) const noexcept {
+            auto size = TraceSize();
+            if (tag_ == Tag::Array) {
+                for (const auto& value : payload_.array) {
+                    if (size >= limit) {
+                        break;
+                    }
+                    size += value.GetImpl().SubtreeTraceSize(limit - size);
+                }
+            } else if (tag_ == Tag::Object) {
+                for (const auto& entry : payload_.object) {
+                    if (size >= limit) {
+                        break;
+                    }
+                    size +=
+                        entry.second.GetImpl().SubtreeTraceSize(limit - size);
+                }
+            }
+            return size;
+        }
+#endif
+
         template <class Type, class... Args>
         void EmplaceRaw(Args&&... args) {
             new (std::addressof(payload_)) Type{std::forward<Args>(args)...};
@@ -1007,6 +2065,88 @@ class BasicDynamic {
             std::forward<Arg>(arg));
     }
 
+    // Collects the entries of an object, then builds it in one pass: a flat
+    // map is sorted once rather than shifted on every insertion, and a hash
+    // table is sized once.
+    class ObjectBuilder {
+       public:
+        explicit ObjectBuilder(
+            const DuplicateKeys duplicates = DuplicateKeys::KeepLast)
+            : duplicates_(duplicates) {}
+
+        ObjectBuilder& Reserve(const std::size_t count) {
+            entries_.reserve(count);
+            return *this;
+        }
+
+        // Keys are converted as by operator[], so may be integers.
+        template <class Key>
+        ObjectBuilder& Add(Key&& key, BasicDynamic value) {
+            entries_.emplace_back(MakeKey(std::forward<Key>(key)),
+                                  std::move(value));
+            return *this;
+        }
+        template <class Key, class Value,
+                  typename std::enable_if<
+                      !std::is_same<typename std::decay<Value>::type,
+                                    BasicDynamic>::value,
+                      int>::type = 0>
+        ObjectBuilder& Add(Key&& key, Value&& value) {
+            return Add(std::forward<Key>(key), Of(std::forward<Value>(value)));
+        }
+
+        DNODISCARD std::size_t size() const noexcept {
+            return entries_.size();
+        }
+
+        // Throws std::invalid_argument on a repeated key if the builder was
+        // made with DuplicateKeys::Throw. Leaves the builder empty.
+        DNODISCARD BasicDynamic Finish() {
+            auto entries = std::move(entries_);
+            entries_.clear();
+            auto object = From<Object>();
+            detail::AssembleObject<detail::IsStdFlatMap<Object>::value>{}(
+                object.GetObject(), entries, duplicates_);
+            return object;
+        }
+
+       private:
+        static std::string MakeKey(std::string&& key) {
+            return std::move(key);
+        }
+        template <class Key>
+        static std::string MakeKey(const Key& key) {
+            return std::string(ToString{}.template Convert<std::string>(key));
+        }
+
+        std::vector<std::pair<std::string, BasicDynamic>> entries_;
+        DuplicateKeys duplicates_;
+    };
+
+    // An object holding the key/value pairs of [first, last), built by an
+    // ObjectBuilder.
+    template <class Iterator>
+    DNODISCARD static BasicDynamic FromPairs(
+        Iterator first, const Iterator last,
+        const DuplicateKeys duplicates = DuplicateKeys::KeepLast) {
+        ObjectBuilder builder(duplicates);
+        builder.Reserve(detail::RangeSize(
+            first, last,
+            typename std::iterator_traits<Iterator>::iterator_category{}));
+        for (; first != last; ++first) {
+            builder.Add(first->first, first->second);
+        }
+        return builder.Finish();
+    }
+    template <class Pairs>
+    DNODISCARD static BasicDynamic FromPairs(
+        const Pairs& pairs,
+        const DuplicateKeys duplicates = DuplicateKeys::KeepLast) {
+        using std::begin;
+        using std::end;
+        return FromPairs(begin(pairs), end(pairs), duplicates);
+    }
+
     template <class Type, class... Args>
     void Emplace(Args&&... args) {
         GetImpl().template Emplace<Type>(std::forward<Args>(args)...);
@@ -1016,7 +2156,7 @@ class BasicDynamic {
         return GetImpl().HoldsNull();
     }
     DNODISCARD constexpr bool IsBoolean() const noexcept {
-        return GetImpl().HoldsBool();
+        return GetImpl().HoldsBoolean();
     }
     DNODISCARD constexpr bool IsInteger() const noexcept {
         return GetImpl().HoldsInteger();
@@ -1036,6 +2176,12 @@ class BasicDynamic {
     DNODISCARD constexpr bool IsObject() const noexcept {
         return GetImpl().HoldsObject();
     }
+    DNODISCARD constexpr bool IsStringView() const noexcept {
+        return GetImpl().HoldsStringView();
+    }
+    DNODISCARD constexpr bool IsBlobView() const noexcept {
+        return GetImpl().HoldsBlobView();
+    }
     DNODISCARD constexpr bool IsUndefined() const noexcept {
         return GetImpl().HoldsUndefined();
     }
@@ -1080,6 +2226,35 @@ class BasicDynamic {
         return GetImpl().GetObject();
     }
 
+    DNODISCARD DCONSTEXPR_14 StringView GetStringView() const {
+        return GetImpl().GetStringView();
+    }
+
+    DNODISCARD DCONSTEXPR_14 BlobView GetBlobView() const {
+        return GetImpl().GetBlobView();
+    }
+
+    // A view of the string, whether it is owned or borrowed. A string of
+    // several chunks, such as a Rope that has not been flattened, has no
+    // single view, and throws std::logic_error.
+    DNODISCARD DCONSTEXPR_14 StringView ToStringView() const {
+        const auto& impl = GetImpl();
+        if (impl.HoldsStringView()) {
+            return impl.payload_.string_view;
+        }
+        return ViewOf(impl.GetString());
+    }
+
+    // A view of the blob, whether it is owned or borrowed.
+    DNODISCARD DCONSTEXPR_14 BlobView ToBlobView() const {
+        const auto& impl = GetImpl();
+        if (impl.HoldsBlobView()) {
+            return impl.payload_.blob_view;
+        }
+        const auto& blob = impl.GetBlob();
+        return BlobView(blob.data(), blob.size());
+    }
+
     DNODISCARD DCONSTEXPR_14 Undefined GetUndefined() const {
         return GetImpl().GetUndefined();
     }
@@ -1110,13 +2285,26 @@ class BasicDynamic {
     }
 
     DNODISCARD BasicDynamic Clone() const {
-        return BasicDynamic{
-            detail::DefaultFactory<ImplWrapper<Impl>>{}(GetImpl().Clone())};
+        DTRACE(Clone, this, GetImpl().TraceSize());
+        return CloneTree();
     }
 
+    // Owned and borrowed strings (and blobs) are equal when their contents
+    // are, so that Materialize() never changes the result.
     DNODISCARD DCONSTEXPR_14 bool Equals(
         const BasicDynamic& rhs) const noexcept {
         if (GetImpl().tag_ != rhs.GetImpl().tag_) {
+            if (IsStringLike() && rhs.IsStringLike()) {
+                // One holds a String and the other a StringView.
+                const auto view =
+                    IsStringView() ? GetStringView() : rhs.GetStringView();
+                return detail::TextEquals(
+                    IsString() ? GetString() : rhs.GetString(), view.data(),
+                    view.size());
+            }
+            if (IsBlobLike() && rhs.IsBlobLike()) {
+                return ToBlobView() == rhs.ToBlobView();
+            }
             return false;
         }
         return GetImpl().Equals(rhs.GetImpl());
@@ -1193,7 +2381,9 @@ class BasicDynamic {
    private:
     template <class Key>
     DNODISCARD BasicDynamic& AtKey(const Key& key) {
-        return As<Object>()[key];
+        auto& object = As<Object>();
+        DTRACE_GROWTH(object, this);
+        return object[key];
     }
     template <class Key>
     DNODISCARD const BasicDynamic& AtKey(const Key& key) const {
@@ -1211,6 +2401,7 @@ class BasicDynamic {
     template <class Type>
     DCONSTEXPR_20 void Push(Type&& value) {
         auto& array = As<Array>();
+        DTRACE_GROWTH(array, this);
         array.emplace_back(
             BasicDynamic::From<typename BestFitFor<typename std::remove_cv<
                 typename std::remove_reference<Type>::type>::type>::type>(
@@ -1234,6 +2425,75 @@ class BasicDynamic {
         }
     }
 
+    // Replaces every StringView and BlobView in the document with an owned
+    // copy, so that it no longer depends on the buffer they point into.
+    void Materialize() {
+        auto& impl = GetImpl();
+        switch (impl.tag_) {
+            case Tag::StringView: {
+                const auto view = impl.payload_.string_view;
+                Emplace<String>(view.data(), view.size());
+                break;
+            }
+            case Tag::BlobView: {
+                const auto view = impl.payload_.blob_view;
+                Emplace<Blob>(view.begin(), view.end());
+                break;
+            }
+            case Tag::Array: {
+                for (auto&& value : impl.payload_.array) {
+                    value.Materialize();
+                }
+                break;
+            }
+            case Tag::Object: {
+                for (auto&& entry : impl.payload_.object) {
+                    entry.second.Materialize();
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // Whether the document still holds a StringView or BlobView anywhere.
+    DNODISCARD bool HasViews() const {
+        const auto& impl = GetImpl();
+        switch (impl.tag_) {
+            case Tag::StringView:
+            case Tag::BlobView:
+                return true;
+            case Tag::Array: {
+                for (const auto& value : impl.payload_.array) {
+                    if (value.HasViews()) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            case Tag::Object: {
+                for (const auto& entry : impl.payload_.object) {
+                    if (entry.second.HasViews()) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            default:
+                return false;
+        }
+    }
+
+    // Walks the whole document; costs time linear in its size.
+    DNODISCARD MemoryFootprint MemoryUsage() const {
+        MemoryFootprint footprint;
+        footprint.inline_bytes += sizeof(BasicDynamic);
+        footprint.exclusive_bytes += sizeof(BasicDynamic);
+        AccumulateMemoryUsage(footprint, false);
+        return footprint;
+    }
+
     template <class Key>
 #if HAS_CONCEPTS
         requires requires(Object o, Key k) { o.find(k); }
@@ -1244,8 +2504,128 @@ class BasicDynamic {
     }
 
    private:
+    DNODISCARD BasicDynamic CloneTree() const {
+        return BasicDynamic{
+            detail::DefaultFactory<ImplWrapper<Impl>>{}(GetImpl().Clone())};
+    }
+
+    // Adds what this value owns, excluding its own inline bytes which belong
+    // to whoever holds it. Everything under a handle that is referenced more
+    // than once is shared.
+    void AccumulateMemoryUsage(MemoryFootprint& footprint, bool shared) const {
+        shared = shared || detail::UseCount(impl_) > 1;
+
+        const auto total_before = footprint.Total();
+        const auto classified_before =
+            footprint.exclusive_bytes + footprint.shared_bytes;
+
+        footprint.managed_bytes +=
+            detail::memory::WrapperHeapBytes<ImplWrapper<Impl>>::value;
+
+        const auto& impl = GetImpl();
+        switch (impl.tag_) {
+            case Tag::Integer: {
+                footprint.number_bytes +=
+                    detail::memory::HeapBytesOf(impl.payload_.integer);
+                break;
+            }
+            case Tag::Number: {
+                footprint.number_bytes +=
+                    detail::memory::HeapBytesOf(impl.payload_.number);
+                break;
+            }
+            case Tag::String: {
+                footprint.string_bytes +=
+                    detail::memory::StringHeapBytes(impl.payload_.string);
+                break;
+            }
+            case Tag::Blob: {
+                const auto& blob = impl.payload_.blob;
+                footprint.blob_bytes +=
+                    blob.size() * sizeof(typename Blob::value_type);
+                footprint.container_overhead +=
+                    detail::memory::SequenceSlackBytes(blob);
+                break;
+            }
+            case Tag::StringView: {
+                footprint.borrowed_bytes +=
+                    impl.payload_.string_view.size() *
+                    sizeof(typename String::value_type);
+                break;
+            }
+            case Tag::BlobView: {
+                footprint.borrowed_bytes +=
+                    impl.payload_.blob_view.size() *
+                    sizeof(typename Blob::value_type);
+                break;
+            }
+            case Tag::Array: {
+                const auto& array = impl.payload_.array;
+                footprint.inline_bytes += array.size() * sizeof(BasicDynamic);
+                footprint.container_overhead +=
+                    detail::memory::SequenceSlackBytes(array);
+                for (const auto& value : array) {
+                    value.AccumulateMemoryUsage(footprint, shared);
+                }
+                break;
+            }
+            case Tag::Object: {
+                const auto& object = impl.payload_.object;
+                footprint.inline_bytes += object.size() * sizeof(BasicDynamic);
+                footprint.container_overhead +=
+                    detail::memory::MapOverheadBytes(object);
+                for (const auto& entry : object) {
+                    footprint.key_bytes +=
+                        sizeof(entry.first) +
+                        detail::memory::StringHeapBytes(entry.first);
+                    entry.second.AccumulateMemoryUsage(footprint, shared);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        // Children have classified their own bytes already.
+        const auto owned =
+            (footprint.Total() - total_before) -
+            (footprint.exclusive_bytes + footprint.shared_bytes -
+             classified_before);
+        if (shared) {
+            footprint.shared_bytes += owned;
+        } else {
+            footprint.exclusive_bytes += owned;
+        }
+    }
+
+    DNODISCARD constexpr bool IsStringLike() const noexcept {
+        return IsString() || IsStringView();
+    }
+    DNODISCARD constexpr bool IsBlobLike() const noexcept {
+        return IsBlob() || IsBlobView();
+    }
+
+    template <class Type,
+              typename std::enable_if<!detail::HasChunks<Type>(), int>::type = 0>
+    static StringView ViewOf(const Type& string) {
+        return StringView(string.data(), string.size());
+    }
+    template <class Type,
+              typename std::enable_if<detail::HasChunks<Type>(), int>::type = 0>
+    static StringView ViewOf(const Type& string) {
+        if (string.ChunkCount() > 1) {
+            throw std::logic_error("String must be flattened to be viewed");
+        }
+        if (string.empty()) {
+            return StringView();
+        }
+        const auto chunk = *string.Chunks().begin();
+        return StringView(chunk.data(), chunk.size());
+    }
+
     [[noreturn]]
     static void InvalidAccess() {
+        DTRACE(InvalidAccess, nullptr, 0);
         throw InvalidAccessException("Invalid access attempted");
     }
 
@@ -1280,6 +2660,19 @@ using DynamicManaged =
                  DefaultObjectContainer, DefaultToString, DefaultToIndex,
                  std::shared_ptr>;
 
+// Defined by the dynamicxx_core library, which instantiates Dynamic and
+// DynamicManaged once so that the translation units using them do not have to.
+#if DYNAMICXX_EXTERN_TEMPLATES
+extern template class BasicDynamic<DefaultInteger, DefaultNumber, DefaultString,
+                                   DefaultBlobContainer, DefaultArrayContainer,
+                                   DefaultObjectContainer, DefaultToString,
+                                   DefaultToIndex, detail::Just>;
+extern template class BasicDynamic<DefaultInteger, DefaultNumber, DefaultString,
+                                   DefaultBlobContainer, DefaultArrayContainer,
+                                   DefaultObjectContainer, DefaultToString,
+                                   DefaultToIndex, std::shared_ptr>;
+#endif
+
 namespace detail {
 
 template <class T>
@@ -0,0 +1,341 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Allocation counting for dynamicxx containers.
+//
+// The counting allocator and the Instrumented* containers can be used with any
+// BasicDynamic. When DYNAMICXX_INSTRUMENT is defined to 1, dynamicxx.h also
+// switches the default Array and Object containers, and the Impl of
+// DynamicManaged, over to them. The default String and Blob stay std::string
+// and std::vector, so existing code keeps compiling; use InstrumentedString and
+// InstrumentedBlobContainer explicitly to count those as well.
+//
+// Counters are kept per thread, so recording an allocation never contends
+// with other threads, and are summed across threads when stats() is called.
+
+#ifndef DYNAMICXX_INSTRUMENT_H
+#define DYNAMICXX_INSTRUMENT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if __cpp_lib_flat_map >= 202207L
+#include <flat_map>
+#else
+#include <unordered_map>
+#endif
+
+namespace dynamicxx {
+
+enum struct AllocationKind : std::uint32_t {
+    String = 0,
+    Blob,
+    Array,
+    Object,
+    Impl,
+};
+
+struct AllocationCounters {
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t bytes_allocated = 0;
+    std::uint64_t bytes_deallocated = 0;
+
+    std::uint64_t LiveAllocations() const noexcept {
+        return allocations - deallocations;
+    }
+    std::uint64_t LiveBytes() const noexcept {
+        return bytes_allocated - bytes_deallocated;
+    }
+
+    AllocationCounters& operator+=(const AllocationCounters& that) noexcept {
+        allocations += that.allocations;
+        deallocations += that.deallocations;
+        bytes_allocated += that.bytes_allocated;
+        bytes_deallocated += that.bytes_deallocated;
+        return *this;
+    }
+    AllocationCounters& operator-=(const AllocationCounters& that) noexcept {
+        allocations -= that.allocations;
+        deallocations -= that.deallocations;
+        bytes_allocated -= that.bytes_allocated;
+        bytes_deallocated -= that.bytes_deallocated;
+        return *this;
+    }
+};
+
+struct AllocationStats {
+    static constexpr std::size_t KindCount =
+        static_cast<std::size_t>(AllocationKind::Impl) + 1;
+
+    AllocationCounters kinds[KindCount];
+
+    AllocationCounters& Of(const AllocationKind kind) noexcept {
+        return kinds[static_cast<std::size_t>(kind)];
+    }
+    const AllocationCounters& Of(const AllocationKind kind) const noexcept {
+        return kinds[static_cast<std::size_t>(kind)];
+    }
+
+    AllocationCounters Total() const noexcept {
+        AllocationCounters total;
+        for (const auto& counters : kinds) {
+            total += counters;
+        }
+        return total;
+    }
+
+    AllocationStats& operator+=(const AllocationStats& that) noexcept {
+        for (std::size_t i = 0; i < KindCount; ++i) {
+            kinds[i] += that.kinds[i];
+        }
+        return *this;
+    }
+    AllocationStats& operator-=(const AllocationStats& that) noexcept {
+        for (std::size_t i = 0; i < KindCount; ++i) {
+            kinds[i] -= that.kinds[i];
+        }
+        return *this;
+    }
+};
+
+namespace detail {
+
+// Only the owning thread writes its counters, so a relaxed load and store is
+// enough; the atomics only make the reads from stats() well defined.
+class ThreadAllocationCounters {
+   public:
+    void Record(const AllocationKind kind, const bool allocation,
+                const std::size_t bytes) noexcept {
+        auto& counters = counters_[static_cast<std::size_t>(kind)];
+        if (allocation) {
+            Bump(counters.allocations, 1);
+            Bump(counters.bytes_allocated, bytes);
+        } else {
+            Bump(counters.deallocations, 1);
+            Bump(counters.bytes_deallocated, bytes);
+        }
+    }
+
+    AllocationStats Snapshot() const noexcept {
+        AllocationStats stats;
+        for (std::size_t i = 0; i < AllocationStats::KindCount; ++i) {
+            const auto& counters = counters_[i];
+            auto& out = stats.kinds[i];
+            out.allocations =
+                counters.allocations.load(std::memory_order_relaxed);
+            out.deallocations =
+                counters.deallocations.load(std::memory_order_relaxed);
+            out.bytes_allocated =
+                counters.bytes_allocated.load(std::memory_order_relaxed);
+            out.bytes_deallocated =
+                counters.bytes_deallocated.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+   private:
+    struct Counters {
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> deallocations{0};
+        std::atomic<std::uint64_t> bytes_allocated{0};
+        std::atomic<std::uint64_t> bytes_deallocated{0};
+    };
+
+    static void Bump(std::atomic<std::uint64_t>& counter,
+                     const std::uint64_t amount) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + amount,
+                      std::memory_order_relaxed);
+    }
+
+    Counters counters_[AllocationStats::KindCount];
+
+    // Links in the registry's list of live threads, guarded by its mutex.
+    friend class AllocationRegistry;
+    ThreadAllocationCounters* previous_ = nullptr;
+    ThreadAllocationCounters* next_ = nullptr;
+};
+
+// The live threads are kept in an intrusive list, so registering a thread
+// never allocates. That matters because the first thing a thread does with
+// a CountingAllocator may be a noexcept deallocate().
+class AllocationRegistry {
+   public:
+    void Register(ThreadAllocationCounters* counters) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        counters->previous_ = nullptr;
+        counters->next_ = live_;
+        if (live_ != nullptr) {
+            live_->previous_ = counters;
+        }
+        live_ = counters;
+    }
+
+    // Counters of exiting threads are folded into `retired_`, so nothing
+    // they recorded is lost.
+    void Unregister(ThreadAllocationCounters* counters) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_ += counters->Snapshot();
+        if (counters->previous_ != nullptr) {
+            counters->previous_->next_ = counters->next_;
+        } else {
+            live_ = counters->next_;
+        }
+        if (counters->next_ != nullptr) {
+            counters->next_->previous_ = counters->previous_;
+        }
+        counters->previous_ = nullptr;
+        counters->next_ = nullptr;
+    }
+
+    AllocationStats Aggregate() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto stats = AggregateLocked();
+        stats -= reset_point_;
+        return stats;
+    }
+
+    // Resetting never touches the per-thread counters, which could race
+    // with their owners; later aggregates are taken relative to this point.
+    void Reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reset_point_ = AggregateLocked();
+    }
+
+   private:
+    AllocationStats AggregateLocked() const {
+        auto stats = retired_;
+        for (const auto* counters = live_; counters != nullptr;
+             counters = counters->next_) {
+            stats += counters->Snapshot();
+        }
+        return stats;
+    }
+
+    mutable std::mutex mutex_;
+    ThreadAllocationCounters* live_ = nullptr;
+    AllocationStats retired_;
+    AllocationStats reset_point_;
+};
+
+// Intentionally leaked, so that it outlives every thread_local that
+// unregisters from it during shutdown.
+inline AllocationRegistry& GetAllocationRegistry() {
+    static auto* const registry = new AllocationRegistry();
+    return *registry;
+}
+
+class RegisteredThreadCounters {
+   public:
+    RegisteredThreadCounters() { GetAllocationRegistry().Register(&counters_); }
+    ~RegisteredThreadCounters() {
+        GetAllocationRegistry().Unregister(&counters_);
+    }
+
+    RegisteredThreadCounters(const RegisteredThreadCounters&) = delete;
+    RegisteredThreadCounters& operator=(const RegisteredThreadCounters&) =
+        delete;
+
+    ThreadAllocationCounters& Get() noexcept { return counters_; }
+
+   private:
+    ThreadAllocationCounters counters_;
+};
+
+inline void RecordAllocation(const AllocationKind kind, const bool allocation,
+                             const std::size_t bytes) noexcept {
+    thread_local RegisteredThreadCounters counters;
+    counters.Get().Record(kind, allocation, bytes);
+}
+
+}  // namespace detail
+
+// Allocation counts summed over all threads since the last ResetStats().
+inline AllocationStats stats() {
+    return detail::GetAllocationRegistry().Aggregate();
+}
+
+inline void ResetStats() { detail::GetAllocationRegistry().Reset(); }
+
+template <class Type, AllocationKind Kind>
+class CountingAllocator {
+   public:
+    using value_type = Type;
+
+    template <class Other>
+    struct rebind {
+        using other = CountingAllocator<Other, Kind>;  // NOLINT
+    };
+
+    CountingAllocator() noexcept = default;
+    template <class Other>
+    CountingAllocator(const CountingAllocator<Other, Kind>&) noexcept {}
+
+    Type* allocate(const std::size_t count) {
+        auto* const pointer = std::allocator<Type>{}.allocate(count);
+        detail::RecordAllocation(Kind, true, count * sizeof(Type));
+        return pointer;
+    }
+
+    void deallocate(Type* const pointer, const std::size_t count) noexcept {
+        detail::RecordAllocation(Kind, false, count * sizeof(Type));
+        std::allocator<Type>{}.deallocate(pointer, count);
+    }
+
+    template <class Other>
+    bool operator==(const CountingAllocator<Other, Kind>&) const noexcept {
+        return true;
+    }
+    template <class Other>
+    bool operator!=(const CountingAllocator<Other, Kind>&) const noexcept {
+        return false;
+    }
+};
+
+using InstrumentedString =
+    std::basic_string<char, std::char_traits<char>,
+                      CountingAllocator<char, AllocationKind::String>>;
+
+template <class Type>
+using InstrumentedBlobContainer =
+    std::vector<Type, CountingAllocator<Type, AllocationKind::Blob>>;
+
+template <class Type>
+using InstrumentedArrayContainer =
+    std::vector<Type, CountingAllocator<Type, AllocationKind::Array>>;
+
+#if __cpp_lib_flat_map >= 202207L
+template <class Key, class Value>
+using InstrumentedObjectContainer = std::flat_map<
+    Key, Value, std::less<Key>,
+    std::vector<Key, CountingAllocator<Key, AllocationKind::Object>>,
+    std::vector<Value, CountingAllocator<Value, AllocationKind::Object>>>;
+#else
+template <class Key, class Value>
+using InstrumentedObjectContainer = std::unordered_map<
+    Key, Value, std::hash<Key>, std::equal_to<Key>,
+    CountingAllocator<std::pair<const Key, Value>, AllocationKind::Object>>;
+#endif
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_INSTRUMENT_H
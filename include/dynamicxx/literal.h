@@ -0,0 +1,433 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Compile-time documents.
+//
+// A Literal is an immutable, non-owning document built over static arrays and
+// string literals. From C++14 it can be a constant expression and queried at
+// compile time; in C++11 it is still built without allocating or parsing.
+//
+//     constexpr dynamicxx::Literal kPorts[] = {80, 443};
+//     constexpr dynamicxx::LiteralMember kMembers[] = {
+//         {"name", "server"},
+//         {"ports", kPorts},
+//     };
+//     constexpr dynamicxx::Literal kConfig = kMembers;
+//
+//     static_assert(kConfig["ports"][1].GetInteger() == 443, "");
+//     dynamicxx::Dynamic config = kConfig.ToDynamic<dynamicxx::Dynamic>();
+//
+// The arrays a Literal refers to must outlive it, so they are normally
+// namespace-scope constants. Objects whose keys are strictly ascending, in
+// byte order, are looked up with a binary search; others with a linear scan.
+
+#ifndef DYNAMICXX_LITERAL_H
+#define DYNAMICXX_LITERAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+
+enum struct LiteralKind : std::uint8_t {
+    Null = 0,
+    Boolean,
+    Integer,
+    Number,
+    String,
+    Array,
+    Object,
+};
+
+struct LiteralMember;
+
+class Literal {
+   public:
+    constexpr Literal() noexcept : Literal(nullptr) {}
+    constexpr Literal(std::nullptr_t) noexcept
+        : kind_(LiteralKind::Null), sorted_(false), size_(0), payload_() {}
+
+    // A template, so that pointers do not silently convert to Boolean.
+    template <class Type, typename std::enable_if<detail::IsBool<Type>::value,
+                                                  int>::type = 0>
+    constexpr Literal(const Type value) noexcept
+        : kind_(LiteralKind::Boolean), sorted_(false), size_(0),
+          payload_(static_cast<bool>(value)) {}
+
+    template <class Type,
+              typename std::enable_if<std::is_integral<Type>::value &&
+                                          !detail::IsBool<Type>::value,
+                                      int>::type = 0>
+    constexpr Literal(const Type value) noexcept
+        : kind_(LiteralKind::Integer), sorted_(false), size_(0),
+          payload_(static_cast<std::int64_t>(value)) {}
+
+    template <class Type, typename std::enable_if<
+                              std::is_floating_point<Type>::value, int>::type = 0>
+    constexpr Literal(const Type value) noexcept
+        : kind_(LiteralKind::Number), sorted_(false), size_(0),
+          payload_(static_cast<double>(value)) {}
+
+    template <std::size_t Size>
+    constexpr Literal(const char (&value)[Size]) noexcept
+        : Literal(value, Size - 1) {}
+
+    template <std::size_t Size>
+    constexpr Literal(const Literal (&items)[Size]) noexcept
+        : kind_(LiteralKind::Array), sorted_(false), size_(Size),
+          payload_(items) {}
+
+    template <std::size_t Size>
+    DCONSTEXPR_14 Literal(const LiteralMember (&members)[Size]) noexcept;
+
+    // A string that is not a literal, such as one of a static array of
+    // strings. `value` need not be null terminated.
+    DNODISCARD static constexpr Literal StringOf(const char* value,
+                                                 const std::size_t size) {
+        return Literal(value, size);
+    }
+
+    // Arrays and objects from a pointer and a size, which may be empty.
+    DNODISCARD static constexpr Literal ArrayOf(const Literal* items,
+                                                const std::size_t size) {
+        return Literal(items, size);
+    }
+    DNODISCARD static DCONSTEXPR_14 Literal ObjectOf(
+        const LiteralMember* members, const std::size_t size);
+    // As ObjectOf(), for members already known to have strictly ascending
+    // keys; skips the check, so large objects stay cheap to constant
+    // evaluate.
+    DNODISCARD static constexpr Literal SortedObjectOf(
+        const LiteralMember* members, const std::size_t size) {
+        return Literal(members, size, true);
+    }
+
+    DNODISCARD constexpr LiteralKind Kind() const noexcept { return kind_; }
+
+    DNODISCARD constexpr bool IsNull() const noexcept {
+        return kind_ == LiteralKind::Null;
+    }
+    DNODISCARD constexpr bool IsBoolean() const noexcept {
+        return kind_ == LiteralKind::Boolean;
+    }
+    DNODISCARD constexpr bool IsInteger() const noexcept {
+        return kind_ == LiteralKind::Integer;
+    }
+    DNODISCARD constexpr bool IsNumber() const noexcept {
+        return kind_ == LiteralKind::Number;
+    }
+    DNODISCARD constexpr bool IsString() const noexcept {
+        return kind_ == LiteralKind::String;
+    }
+    DNODISCARD constexpr bool IsArray() const noexcept {
+        return kind_ == LiteralKind::Array;
+    }
+    DNODISCARD constexpr bool IsObject() const noexcept {
+        return kind_ == LiteralKind::Object;
+    }
+
+    // Whether an object's keys are strictly ascending, so that lookups are a
+    // binary search.
+    DNODISCARD constexpr bool IsSorted() const noexcept { return sorted_; }
+
+    DNODISCARD DCONSTEXPR_14 bool GetBoolean() const {
+        Expect(LiteralKind::Boolean);
+        return payload_.boolean;
+    }
+    DNODISCARD DCONSTEXPR_14 std::int64_t GetInteger() const {
+        Expect(LiteralKind::Integer);
+        return payload_.integer;
+    }
+    DNODISCARD DCONSTEXPR_14 double GetNumber() const {
+        Expect(LiteralKind::Number);
+        return payload_.number;
+    }
+    // Not null terminated when made with StringOf(); use size().
+    DNODISCARD DCONSTEXPR_14 const char* GetString() const {
+        Expect(LiteralKind::String);
+        return payload_.string;
+    }
+    DNODISCARD DCONSTEXPR_14 const Literal* GetArray() const {
+        Expect(LiteralKind::Array);
+        return payload_.array;
+    }
+    DNODISCARD DCONSTEXPR_14 const LiteralMember* GetObject() const {
+        Expect(LiteralKind::Object);
+        return payload_.object;
+    }
+
+    // Length of strings, element count of arrays and objects.
+    DNODISCARD constexpr std::size_t size() const noexcept { return size_; }
+
+    DNODISCARD DCONSTEXPR_14 const Literal& operator[](
+        const std::size_t index) const {
+        Expect(LiteralKind::Array);
+        if (index >= size_) {
+            throw InvalidAccessException("Literal index out of range");
+        }
+        return payload_.array[index];
+    }
+
+    template <std::size_t Size>
+    DNODISCARD DCONSTEXPR_14 const Literal& operator[](
+        const char (&key)[Size]) const;
+
+    // The value of `key`, or nullptr if the object has no such member.
+    DNODISCARD DCONSTEXPR_14 const Literal* Find(const char* key,
+                                                 std::size_t key_size) const;
+    template <std::size_t Size>
+    DNODISCARD DCONSTEXPR_14 const Literal* Find(
+        const char (&key)[Size]) const {
+        return Find(key, Size - 1);
+    }
+
+    DNODISCARD DCONSTEXPR_14 bool Contains(const char* key,
+                                           const std::size_t key_size) const {
+        return Find(key, key_size) != nullptr;
+    }
+    template <std::size_t Size>
+    DNODISCARD DCONSTEXPR_14 bool Contains(const char (&key)[Size]) const {
+        return Find(key, Size - 1) != nullptr;
+    }
+
+    // Runtime lookups by a key of any length.
+    DNODISCARD const Literal& operator[](const std::string& key) const {
+        return At(key);
+    }
+    DNODISCARD const Literal* Find(const std::string& key) const {
+        return Find(key.data(), key.size());
+    }
+    DNODISCARD bool Contains(const std::string& key) const {
+        return Find(key.data(), key.size()) != nullptr;
+    }
+
+    DNODISCARD DCONSTEXPR_14 const Literal& At(const char* key,
+                                               std::size_t key_size) const;
+    DNODISCARD const Literal& At(const std::string& key) const {
+        return At(key.data(), key.size());
+    }
+    DNODISCARD DCONSTEXPR_14 const Literal& AtIndex(
+        const std::size_t index) const {
+        return (*this)[index];
+    }
+
+    // Builds the equivalent runtime document. Strings and keys are copied
+    // once, containers are reserved up front, and nothing is parsed.
+    template <class DynamicType>
+    DNODISCARD DynamicType ToDynamic() const;
+
+   private:
+    union Payload {
+        constexpr Payload() noexcept : integer(0) {}
+        constexpr Payload(const bool value) noexcept : boolean(value) {}
+        constexpr Payload(const std::int64_t value) noexcept
+            : integer(value) {}
+        constexpr Payload(const double value) noexcept : number(value) {}
+        constexpr Payload(const char* value) noexcept : string(value) {}
+        constexpr Payload(const Literal* value) noexcept : array(value) {}
+        constexpr Payload(const LiteralMember* value) noexcept
+            : object(value) {}
+
+        bool boolean;
+        std::int64_t integer;
+        double number;
+        const char* string;
+        const Literal* array;
+        const LiteralMember* object;
+    };
+
+    constexpr Literal(const char* value, const std::size_t size) noexcept
+        : kind_(LiteralKind::String), sorted_(false), size_(size),
+          payload_(value) {}
+    constexpr Literal(const Literal* items, const std::size_t size) noexcept
+        : kind_(LiteralKind::Array), sorted_(false), size_(size),
+          payload_(items) {}
+    constexpr Literal(const LiteralMember* members, const std::size_t size,
+                      const bool sorted) noexcept
+        : kind_(LiteralKind::Object), sorted_(sorted), size_(size),
+          payload_(members) {}
+
+    DCONSTEXPR_14 void Expect(const LiteralKind kind) const {
+        if (kind_ != kind) {
+            throw InvalidAccessException("Invalid access attempted");
+        }
+    }
+
+    LiteralKind kind_;
+    bool sorted_;
+    std::size_t size_;
+    Payload payload_;
+};
+
+struct LiteralMember {
+    template <std::size_t Size>
+    constexpr LiteralMember(const char (&key)[Size], const Literal value)
+        : key(key), key_size(Size - 1), value(value) {}
+
+    constexpr LiteralMember(const char* key, const std::size_t key_size,
+                            const Literal value)
+        : key(key), key_size(key_size), value(value) {}
+
+    const char* key;
+    std::size_t key_size;
+    Literal value;
+};
+
+namespace detail {
+namespace literal {
+
+// Byte-wise three-way comparison, matching std::char_traits<char>::compare.
+DNODISCARD DCONSTEXPR_14 inline int CompareKeys(const char* lhs,
+                                         const std::size_t lhs_size,
+                                         const char* rhs,
+                                         const std::size_t rhs_size) noexcept {
+    const auto common = lhs_size < rhs_size ? lhs_size : rhs_size;
+    for (std::size_t i = 0; i < common; ++i) {
+        const auto left = static_cast<unsigned char>(lhs[i]);
+        const auto right = static_cast<unsigned char>(rhs[i]);
+        if (left != right) {
+            return left < right ? -1 : 1;
+        }
+    }
+    if (lhs_size == rhs_size) {
+        return 0;
+    }
+    return lhs_size < rhs_size ? -1 : 1;
+}
+
+DNODISCARD DCONSTEXPR_14 inline bool StrictlyAscending(
+    const LiteralMember* members, const std::size_t size) noexcept {
+    for (std::size_t i = 1; i < size; ++i) {
+        if (CompareKeys(members[i - 1].key, members[i - 1].key_size,
+                        members[i].key, members[i].key_size) >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace literal
+}  // namespace detail
+
+template <std::size_t Size>
+DCONSTEXPR_14 Literal::Literal(const LiteralMember (&members)[Size]) noexcept
+    : Literal(members, Size,
+              detail::literal::StrictlyAscending(members, Size)) {}
+
+DCONSTEXPR_14 inline Literal Literal::ObjectOf(const LiteralMember* members,
+                                               const std::size_t size) {
+    return Literal(members, size,
+                   detail::literal::StrictlyAscending(members, size));
+}
+
+DCONSTEXPR_14 inline const Literal* Literal::Find(
+    const char* key, const std::size_t key_size) const {
+    Expect(LiteralKind::Object);
+    const auto* const members = payload_.object;
+    if (sorted_) {
+        std::size_t low = 0;
+        std::size_t high = size_;
+        while (low < high) {
+            const auto middle = low + (high - low) / 2;
+            const auto order = detail::literal::CompareKeys(
+                members[middle].key, members[middle].key_size, key, key_size);
+            if (order == 0) {
+                return &members[middle].value;
+            }
+            if (order < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return nullptr;
+    }
+    for (std::size_t i = 0; i < size_; ++i) {
+        if (detail::literal::CompareKeys(members[i].key, members[i].key_size,
+                                         key, key_size) == 0) {
+            return &members[i].value;
+        }
+    }
+    return nullptr;
+}
+
+DCONSTEXPR_14 inline const Literal& Literal::At(
+    const char* key, const std::size_t key_size) const {
+    const auto* const value = Find(key, key_size);
+    if (value == nullptr) {
+        throw InvalidAccessException("Literal has no such member");
+    }
+    return *value;
+}
+
+template <std::size_t Size>
+DCONSTEXPR_14 const Literal& Literal::operator[](
+    const char (&key)[Size]) const {
+    return At(key, Size - 1);
+}
+
+template <class DynamicType>
+DynamicType Literal::ToDynamic() const {
+    switch (kind_) {
+        case LiteralKind::Null:
+            return DynamicType::template From<typename DynamicType::Null>();
+        case LiteralKind::Boolean:
+            return DynamicType::template From<typename DynamicType::Boolean>(
+                payload_.boolean);
+        case LiteralKind::Integer:
+            return DynamicType::template From<typename DynamicType::Integer>(
+                static_cast<typename DynamicType::Integer>(payload_.integer));
+        case LiteralKind::Number:
+            return DynamicType::template From<typename DynamicType::Number>(
+                static_cast<typename DynamicType::Number>(payload_.number));
+        case LiteralKind::String:
+            return DynamicType::template From<typename DynamicType::String>(
+                payload_.string, size_);
+        case LiteralKind::Array: {
+            auto dynamic =
+                DynamicType::template From<typename DynamicType::Array>();
+            auto& array = dynamic.GetArray();
+            detail::reserve(array, size_);
+            for (std::size_t i = 0; i < size_; ++i) {
+                array.push_back(
+                    payload_.array[i].template ToDynamic<DynamicType>());
+            }
+            return dynamic;
+        }
+        case LiteralKind::Object: {
+            auto dynamic =
+                DynamicType::template From<typename DynamicType::Object>();
+            auto& object = dynamic.GetObject();
+            detail::reserve(object, size_);
+            for (std::size_t i = 0; i < size_; ++i) {
+                const auto& member = payload_.object[i];
+                object.emplace(
+                    std::string(member.key, member.key_size),
+                    member.value.template ToDynamic<DynamicType>());
+            }
+            return dynamic;
+        }
+    }
+    throw InvalidAccessException("Invalid literal kind");
+}
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_LITERAL_H
@@ -0,0 +1,311 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Correctly rounded, locale-independent parsing of decimal text to double.
+//
+// Digits are read eight at a time with the same SWAR routines as
+// ParseInteger() in dynamicxx.h. A value with at most 19 significant digits is
+// then converted exactly when both its digits and its power of ten are exact
+// doubles, and otherwise with the Eisel-Lemire algorithm: one or two 64x64-bit
+// multiplications by a table of 128-bit powers of five. Longer inputs, and the
+// rare products too close to a rounding boundary for Eisel-Lemire to decide,
+// fall back to the standard library.
+
+#ifndef DYNAMICXX_NUMERIC_H
+#define DYNAMICXX_NUMERIC_H
+
+#include <cfloat>
+#include <clocale>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "dynamicxx/dynamicxx.h"
+#include "dynamicxx/pow5_table.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace dynamicxx {
+namespace detail {
+namespace numeric {
+
+inline int LeadingZeros(const std::uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return 63 - static_cast<int>(index);
+#else
+    int count = 0;
+    for (std::uint64_t bit = std::uint64_t{1} << 63; (value & bit) == 0;
+         bit >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// The full 128-bit product of two 64-bit values.
+inline void Multiply128(const std::uint64_t a, const std::uint64_t b,
+                        std::uint64_t& high, std::uint64_t& low) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 Uint128;
+    const Uint128 product = static_cast<Uint128>(a) * b;
+    high = static_cast<std::uint64_t>(product >> 64);
+    low = static_cast<std::uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    low = _umul128(a, b, &high);
+#else
+    const std::uint64_t a_low = a & 0xFFFFFFFFU;
+    const std::uint64_t a_high = a >> 32;
+    const std::uint64_t b_low = b & 0xFFFFFFFFU;
+    const std::uint64_t b_high = b >> 32;
+    const std::uint64_t low_low = a_low * b_low;
+    const std::uint64_t high_low = a_high * b_low;
+    const std::uint64_t low_high = a_low * b_high;
+    const std::uint64_t middle =
+        (low_low >> 32) + (high_low & 0xFFFFFFFFU) + low_high;
+    high = a_high * b_high + (high_low >> 32) + (middle >> 32);
+    low = (middle << 32) | (low_low & 0xFFFFFFFFU);
+#endif
+}
+
+inline double FromBits(const std::uint64_t bits) noexcept {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Clinger's fast path: exact when the digits and the power of ten are both
+// exactly representable, since IEEE arithmetic then rounds only once.
+inline bool ConvertExactly(const std::uint64_t mantissa,
+                           const std::int64_t exponent, const bool negative,
+                           double& value) noexcept {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    static const double powers[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    if (exponent < -22 || exponent > 22 ||
+        mantissa > (std::uint64_t{1} << 53)) {
+        return false;
+    }
+    value = static_cast<double>(mantissa);
+    if (exponent < 0) {
+        value /= powers[-exponent];
+    } else {
+        value *= powers[exponent];
+    }
+    if (negative) {
+        value = -value;
+    }
+    return true;
+#else
+    (void)mantissa;
+    (void)exponent;
+    (void)negative;
+    (void)value;
+    return false;
+#endif
+}
+
+// Eisel-Lemire: mantissa * 10^exponent, correctly rounded, for a mantissa of
+// at most 19 digits. Returns false in the rare cases it cannot decide.
+inline bool ConvertEiselLemire(std::uint64_t mantissa,
+                               const std::int64_t exponent,
+                               const bool negative, double& value) noexcept {
+    const std::uint64_t sign = negative ? std::uint64_t{1} << 63 : 0;
+    const std::uint64_t infinity = 0x7FF0000000000000U;
+    if (mantissa == 0 || exponent < SmallestPowerOfFive) {
+        value = FromBits(sign);
+        return true;
+    }
+    if (exponent > LargestPowerOfFive) {
+        value = FromBits(sign | infinity);
+        return true;
+    }
+
+    const int zeros = LeadingZeros(mantissa);
+    mantissa <<= zeros;
+    const std::uint64_t* power =
+        PowersOfFive() + 2 * (exponent - SmallestPowerOfFive);
+    std::uint64_t high;
+    std::uint64_t low;
+    Multiply128(mantissa, power[0], high, low);
+    // The top 55 bits are what matter; if the rest are all ones, a carry from
+    // the low half of the power could still change them.
+    if ((high & 0x1FF) == 0x1FF) {
+        std::uint64_t carry;
+        std::uint64_t ignored;
+        Multiply128(mantissa, power[1], carry, ignored);
+        low += carry;
+        if (carry > low) {
+            ++high;
+        }
+    }
+    if (low == ~std::uint64_t{0} && (exponent < -27 || exponent > 55)) {
+        return false;
+    }
+
+    const int upper = static_cast<int>(high >> 63);
+    std::uint64_t bits = high >> (upper + 9);
+    // floor(log2(10^exponent)) + 63, plus the double exponent bias.
+    std::int64_t power2 =
+        ((217706 * exponent) >> 16) + 63 + upper - zeros + 1023;
+    if (power2 <= 0) {
+        // Subnormal.
+        if (-power2 + 1 >= 64) {
+            value = FromBits(sign);
+            return true;
+        }
+        bits >>= -power2 + 1;
+        bits += bits & 1;
+        bits >>= 1;
+        value = FromBits(sign | bits);
+        return true;
+    }
+    // Exactly halfway between two doubles: round to even rather than up.
+    if (low <= 1 && exponent >= -4 && exponent <= 23 && (bits & 3) == 1 &&
+        (bits << (upper + 9)) == high) {
+        bits &= ~std::uint64_t{1};
+    }
+    bits += bits & 1;
+    bits >>= 1;
+    if (bits >= (std::uint64_t{2} << 52)) {
+        bits = std::uint64_t{1} << 52;
+        ++power2;
+    }
+    bits &= ~(std::uint64_t{1} << 52);
+    if (power2 >= 0x7FF) {
+        value = FromBits(sign | infinity);
+        return true;
+    }
+    value = FromBits(sign | bits | (static_cast<std::uint64_t>(power2) << 52));
+    return true;
+}
+
+// The C library's conversion. It overflows to HUGE_VAL, which is infinity,
+// and underflows to zero or a subnormal. Streams are no use here, as some
+// fail on underflow as well as overflow. strtod reads the decimal point of
+// the global C locale, so the '.' is swapped for it.
+inline double ConvertSlowly(const char* first, const char* last) {
+    std::string text(first, last);
+    const char* const point = std::localeconv()->decimal_point;
+    if (point[0] != '.' || point[1] != '\0') {
+        const auto dot = text.find('.');
+        if (dot != std::string::npos) {
+            text.replace(dot, 1, point);
+        }
+    }
+    return std::strtod(text.c_str(), nullptr);
+}
+
+// Reads digits into `mantissa`, which wraps around if there are more than 19.
+inline const char* ReadDigits(const char* str, const char* last,
+                              std::uint64_t& mantissa) noexcept {
+    while (last - str >= 8 && IsEightDigits(LoadEight(str))) {
+        mantissa = mantissa * 100000000 + ParseEightDigits(LoadEight(str));
+        str += 8;
+    }
+    while (str != last && IsDigit(*str)) {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*str - '0');
+        ++str;
+    }
+    return str;
+}
+
+}  // namespace numeric
+}  // namespace detail
+
+// Parses a decimal number at the start of [first, last): an optional '-',
+// digits with an optional fraction, and an optional exponent, as in JSON or
+// std::strtod without hexadecimal, infinities or NaN. The result is
+// correctly rounded. Underflow gives zero; overflow is an error that leaves
+// `value` unchanged.
+inline ParseResult ParseNumber(const char* first, const char* last,
+                               double& value) {
+    const char* str = first;
+    const bool negative = str != last && *str == '-';
+    if (negative) {
+        ++str;
+    }
+    const char* const digits = str;
+    std::uint64_t mantissa = 0;
+    str = detail::numeric::ReadDigits(str, last, mantissa);
+    std::int64_t digit_count = str - digits;
+    std::int64_t exponent = 0;
+    if (str != last && *str == '.') {
+        const char* const fraction = ++str;
+        str = detail::numeric::ReadDigits(str, last, mantissa);
+        exponent = -(str - fraction);
+        digit_count += str - fraction;
+    }
+    if (digit_count == 0) {
+        return ParseResult{first, ParseError::Empty};
+    }
+    if (str != last && (*str == 'e' || *str == 'E')) {
+        const char* const marker = str++;
+        const bool negative_exponent = str != last && *str == '-';
+        if (str != last && (*str == '-' || *str == '+')) {
+            ++str;
+        }
+        if (str == last || !detail::IsDigit(*str)) {
+            // Not an exponent after all, as in "1e" or "2ex".
+            str = marker;
+        } else {
+            std::int64_t written = 0;
+            for (; str != last && detail::IsDigit(*str); ++str) {
+                if (written < 100000000) {
+                    written = written * 10 + (*str - '0');
+                }
+            }
+            exponent += negative_exponent ? -written : written;
+        }
+    }
+
+    if (digit_count > 19) {
+        // Leading zeros are not significant.
+        for (const char* c = digits; c != str && (*c == '0' || *c == '.');
+             ++c) {
+            if (*c == '0') {
+                --digit_count;
+            }
+        }
+    }
+    double result;
+    if (digit_count > 19 ||
+        (!detail::numeric::ConvertExactly(mantissa, exponent, negative,
+                                          result) &&
+         !detail::numeric::ConvertEiselLemire(mantissa, exponent, negative,
+                                              result))) {
+        result = detail::numeric::ConvertSlowly(first, str);
+    }
+    if (result == std::numeric_limits<double>::infinity() ||
+        result == -std::numeric_limits<double>::infinity()) {
+        return ParseResult{str, ParseError::Overflow};
+    }
+    value = result;
+    return ParseResult{str, ParseError::None};
+}
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_NUMERIC_H
@@ -0,0 +1,300 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// An insertion-ordered hash map, for objects whose key order must survive a
+// round trip.
+//
+// Entries live in one vector in the order they were inserted, so iteration is
+// a walk over contiguous memory. Lookups go through a separate open-addressed
+// index of 8-byte slots, each holding the position of an entry and 32 bits of
+// its key's hash: probing compares hashes without touching the entries, and
+// growing the index never rehashes a key. The index is kept at most 3/4 full,
+// so the map costs about as much memory as a flat hash table.
+//
+// Erasing preserves the order of the remaining entries, and so is linear in
+// the size of the map.
+
+#ifndef DYNAMICXX_ORDERED_MAP_H
+#define DYNAMICXX_ORDERED_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+
+template <class Key, class Value, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class OrderedMap {
+   public:
+    using key_type = Key;
+    using mapped_type = Value;
+    // Keys must not be modified through an iterator.
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    OrderedMap() = default;
+
+    DNODISCARD size_type size() const noexcept { return entries_.size(); }
+    DNODISCARD bool empty() const noexcept { return entries_.empty(); }
+    DNODISCARD size_type capacity() const noexcept {
+        return entries_.capacity();
+    }
+
+    // Makes room for `count` entries without reallocating or growing the
+    // index.
+    void reserve(const size_type count) {
+        entries_.reserve(count);
+        if (count * 4 > slots_.size() * 3) {
+            Rehash(SlotsFor(count));
+        }
+    }
+
+    void clear() noexcept {
+        entries_.clear();
+        slots_.assign(slots_.size(), Slot{});
+    }
+
+    DNODISCARD iterator begin() noexcept { return entries_.begin(); }
+    DNODISCARD iterator end() noexcept { return entries_.end(); }
+    DNODISCARD const_iterator begin() const noexcept {
+        return entries_.begin();
+    }
+    DNODISCARD const_iterator end() const noexcept { return entries_.end(); }
+    DNODISCARD const_iterator cbegin() const noexcept {
+        return entries_.cbegin();
+    }
+    DNODISCARD const_iterator cend() const noexcept { return entries_.cend(); }
+
+    DNODISCARD iterator find(const Key& key) {
+        const auto slot = FindSlot(key, HashOf(key));
+        return slots_.empty() || slots_[slot].entry == 0
+                   ? end()
+                   : begin() + (slots_[slot].entry - 1);
+    }
+    DNODISCARD const_iterator find(const Key& key) const {
+        const auto slot = FindSlot(key, HashOf(key));
+        return slots_.empty() || slots_[slot].entry == 0
+                   ? end()
+                   : begin() + (slots_[slot].entry - 1);
+    }
+
+    DNODISCARD size_type count(const Key& key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+    DNODISCARD bool contains(const Key& key) const {
+        return find(key) != end();
+    }
+
+    DNODISCARD Value& at(const Key& key) {
+        const auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("OrderedMap::at: key not found");
+        }
+        return it->second;
+    }
+    DNODISCARD const Value& at(const Key& key) const {
+        const auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("OrderedMap::at: key not found");
+        }
+        return it->second;
+    }
+
+    // A new key is appended with a value-initialized Value.
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+    Value& operator[](Key&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    // Appends `key` with a Value made from `args`, unless `key` is already
+    // present, in which case nothing is constructed.
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const auto hash = HashOf(key);
+        auto slot = FindSlot(key, hash);
+        if (!slots_.empty() && slots_[slot].entry != 0) {
+            return {begin() + (slots_[slot].entry - 1), false};
+        }
+        if ((entries_.size() + 1) * 4 > slots_.size() * 3) {
+            Rehash(SlotsFor(entries_.size() + 1));
+            slot = FindSlot(key, hash);
+        }
+        if (entries_.size() >= MaxSize) {
+            throw std::length_error("OrderedMap is full");
+        }
+        entries_.emplace_back(
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        slots_[slot] = Slot{static_cast<std::uint32_t>(entries_.size()), hash};
+        return {end() - 1, true};
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(const Key& key, Args&&... args) {
+        return try_emplace(key, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Key&& key, Args&&... args) {
+        return try_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+    std::pair<iterator, bool> insert(const value_type& entry) {
+        return try_emplace(entry.first, entry.second);
+    }
+    std::pair<iterator, bool> insert(value_type&& entry) {
+        return try_emplace(std::move(entry.first), std::move(entry.second));
+    }
+
+    // Removes the entry for `key`, keeping the order of the others. Returns
+    // the number of entries removed.
+    size_type erase(const Key& key) {
+        const auto it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+    iterator erase(const_iterator position) {
+        const auto index = static_cast<std::size_t>(position - cbegin());
+        entries_.erase(entries_.begin() + static_cast<std::ptrdiff_t>(index));
+        // Reinsert every slot, shifting the positions of later entries down.
+        std::vector<Slot> slots(slots_.size());
+        slots_.swap(slots);
+        const auto removed = static_cast<std::uint32_t>(index + 1);
+        for (const auto& slot : slots) {
+            if (slot.entry != 0 && slot.entry != removed) {
+                Place(Slot{slot.entry > removed ? slot.entry - 1 : slot.entry,
+                           slot.hash});
+            }
+        }
+        return begin() + static_cast<std::ptrdiff_t>(index);
+    }
+
+    // Bytes held by the index, for BasicDynamic::MemoryUsage().
+    DNODISCARD size_type index_bytes() const noexcept {
+        return slots_.capacity() * sizeof(Slot);
+    }
+
+    // Equal when both hold the same keys with equal values; as with the other
+    // object containers, the order of the entries does not matter.
+    DNODISCARD friend bool operator==(const OrderedMap& lhs,
+                                      const OrderedMap& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (const auto& entry : lhs) {
+            const auto it = rhs.find(entry.first);
+            if (it == rhs.end() || !(it->second == entry.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    DNODISCARD friend bool operator!=(const OrderedMap& lhs,
+                                      const OrderedMap& rhs) {
+        return !(lhs == rhs);
+    }
+
+   private:
+    // `entry` is one past the position of the entry in entries_, so that a
+    // zeroed slot is empty.
+    struct Slot {
+        std::uint32_t entry = 0;
+        std::uint32_t hash = 0;
+    };
+
+    static constexpr std::size_t MaxSize = 0x7FFFFFFF;
+
+    template <class K>
+    std::uint32_t HashOf(const K& key) const {
+        const auto hash = static_cast<std::uint64_t>(Hash{}(key));
+        return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+    }
+
+    // The smallest power of two with room for `count` entries at 3/4 load.
+    static std::size_t SlotsFor(const std::size_t count) noexcept {
+        std::size_t slots = 8;
+        while (count * 4 > slots * 3) {
+            slots *= 2;
+        }
+        return slots;
+    }
+
+    // The slot holding `key`, or the empty slot where it would go.
+    template <class K>
+    std::size_t FindSlot(const K& key, const std::uint32_t hash) const {
+        if (slots_.empty()) {
+            return 0;
+        }
+        const auto mask = slots_.size() - 1;
+        for (auto i = hash & mask;; i = (i + 1) & mask) {
+            const auto& slot = slots_[i];
+            if (slot.entry == 0 ||
+                (slot.hash == hash &&
+                 KeyEqual{}(entries_[slot.entry - 1].first, key))) {
+                return i;
+            }
+        }
+    }
+
+    void Place(const Slot slot) noexcept {
+        const auto mask = slots_.size() - 1;
+        auto i = slot.hash & mask;
+        while (slots_[i].entry != 0) {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = slot;
+    }
+
+    void Rehash(const std::size_t count) {
+        std::vector<Slot> slots(count);
+        slots_.swap(slots);
+        for (const auto& slot : slots) {
+            if (slot.entry != 0) {
+                Place(slot);
+            }
+        }
+    }
+
+    std::vector<value_type> entries_;
+    std::vector<Slot> slots_;
+};
+
+template <class Key, class Value, class Hash, class KeyEqual>
+constexpr std::size_t OrderedMap<Key, Value, Hash, KeyEqual>::MaxSize;
+
+// Dynamic, with objects that keep their keys in insertion order.
+using OrderedDynamic =
+    BasicDynamic<DefaultInteger, DefaultNumber, DefaultString,
+                 DefaultBlobContainer, DefaultArrayContainer, OrderedMap,
+                 DefaultToString, DefaultToIndex, detail::Just>;
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_ORDERED_MAP_H
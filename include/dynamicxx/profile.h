@@ -0,0 +1,328 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Shape profiling of documents: how many values of each type they hold, and
+// how large their objects, arrays and strings are. Profiles are meant to be
+// collected from a sample of production documents and merged, to choose
+// container policies for a workload.
+
+#ifndef DYNAMICXX_PROFILE_H
+#define DYNAMICXX_PROFILE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+
+// A histogram with power of two buckets: bucket 0 counts zeros, and bucket
+// k > 0 counts values in [2^(k-1), 2^k). Adding a value is a handful of
+// instructions and never allocates.
+class Histogram {
+   public:
+    static constexpr std::size_t BucketCount = 65;
+
+    void Add(const std::uint64_t value) noexcept {
+        ++buckets_[BucketOf(value)];
+        ++count_;
+        sum_ += value;
+        max_ = std::max(max_, value);
+    }
+
+    DNODISCARD static std::size_t BucketOf(std::uint64_t value) noexcept {
+        std::size_t bucket = 0;
+        while (value != 0) {
+            ++bucket;
+            value >>= 1;
+        }
+        return bucket;
+    }
+
+    // Smallest value counted by the bucket.
+    DNODISCARD static std::uint64_t LowerBound(
+        const std::size_t bucket) noexcept {
+        return bucket == 0 ? 0 : std::uint64_t{1} << (bucket - 1);
+    }
+
+    DNODISCARD std::uint64_t Bucket(const std::size_t bucket) const noexcept {
+        return buckets_[bucket];
+    }
+    DNODISCARD std::uint64_t Count() const noexcept { return count_; }
+    DNODISCARD std::uint64_t Sum() const noexcept { return sum_; }
+    DNODISCARD std::uint64_t Max() const noexcept { return max_; }
+    DNODISCARD double Mean() const noexcept {
+        return count_ == 0 ? 0.0
+                           : static_cast<double>(sum_) /
+                                 static_cast<double>(count_);
+    }
+
+    // An upper bound of the given quantile (in [0, 1]): the largest value
+    // that the bucket containing it can hold, capped at Max().
+    DNODISCARD std::uint64_t Quantile(const double quantile) const noexcept {
+        if (count_ == 0) {
+            return 0;
+        }
+        const auto rank = static_cast<std::uint64_t>(
+            quantile * static_cast<double>(count_ - 1));
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < BucketCount; ++bucket) {
+            seen += buckets_[bucket];
+            if (seen > rank) {
+                const auto upper = bucket == 0 ? 0
+                                   : bucket == BucketCount - 1
+                                       ? max_
+                                       : LowerBound(bucket + 1) - 1;
+                return std::min(upper, max_);
+            }
+        }
+        return max_;
+    }
+
+    Histogram& operator+=(const Histogram& that) noexcept {
+        for (std::size_t bucket = 0; bucket < BucketCount; ++bucket) {
+            buckets_[bucket] += that.buckets_[bucket];
+        }
+        count_ += that.count_;
+        sum_ += that.sum_;
+        max_ = std::max(max_, that.max_);
+        return *this;
+    }
+
+   private:
+    std::uint64_t buckets_[BucketCount] = {};
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+struct ProfileOptions {
+    // Whether to count how often each object key occurs.
+    bool count_keys = true;
+    // Bounds the memory of the key table; occurrences of keys first seen
+    // after the table is full are counted in ShapeProfile::untracked_keys.
+    std::size_t max_distinct_keys = 4096;
+};
+
+struct ShapeProfile {
+    std::uint64_t documents = 0;
+
+    std::uint64_t nulls = 0;
+    std::uint64_t booleans = 0;
+    std::uint64_t integers = 0;
+    std::uint64_t numbers = 0;
+    std::uint64_t strings = 0;
+    std::uint64_t blobs = 0;
+    std::uint64_t arrays = 0;
+    std::uint64_t objects = 0;
+    // Borrowed strings and blobs; their lengths are in the string and blob
+    // histograms.
+    std::uint64_t string_views = 0;
+    std::uint64_t blob_views = 0;
+    std::uint64_t undefined = 0;
+
+    Histogram object_sizes;
+    Histogram array_lengths;
+    Histogram string_lengths;
+    Histogram blob_lengths;
+    // Depth of every value, the root being at depth 0.
+    Histogram depths;
+
+    std::unordered_map<std::string, std::uint64_t> key_frequency;
+    std::uint64_t untracked_keys = 0;
+
+    DNODISCARD std::uint64_t Values() const noexcept {
+        return nulls + booleans + integers + numbers + strings + blobs +
+               arrays + objects + string_views + blob_views + undefined;
+    }
+
+    DNODISCARD std::uint64_t MaxDepth() const noexcept { return depths.Max(); }
+
+    // The `count` most frequent keys, most frequent first.
+    DNODISCARD std::vector<std::pair<std::string, std::uint64_t>> TopKeys(
+        const std::size_t count) const {
+        std::vector<std::pair<std::string, std::uint64_t>> keys(
+            key_frequency.begin(), key_frequency.end());
+        const auto by_frequency =
+            [](const std::pair<std::string, std::uint64_t>& lhs,
+               const std::pair<std::string, std::uint64_t>& rhs) {
+                return lhs.second != rhs.second ? lhs.second > rhs.second
+                                                : lhs.first < rhs.first;
+            };
+        const auto kept = std::min(count, keys.size());
+        std::partial_sort(keys.begin(), keys.begin() + kept, keys.end(),
+                          by_frequency);
+        keys.resize(kept);
+        return keys;
+    }
+
+    // Merges another profile, e.g. one collected on another thread. Keys
+    // beyond `max_distinct_keys` are counted as untracked.
+    void Merge(const ShapeProfile& that,
+               const std::size_t max_distinct_keys =
+                   ProfileOptions{}.max_distinct_keys) {
+        documents += that.documents;
+        nulls += that.nulls;
+        booleans += that.booleans;
+        integers += that.integers;
+        numbers += that.numbers;
+        strings += that.strings;
+        blobs += that.blobs;
+        arrays += that.arrays;
+        objects += that.objects;
+        string_views += that.string_views;
+        blob_views += that.blob_views;
+        undefined += that.undefined;
+        object_sizes += that.object_sizes;
+        array_lengths += that.array_lengths;
+        string_lengths += that.string_lengths;
+        blob_lengths += that.blob_lengths;
+        depths += that.depths;
+        untracked_keys += that.untracked_keys;
+        for (const auto& entry : that.key_frequency) {
+            const auto it = key_frequency.find(entry.first);
+            if (it != key_frequency.end()) {
+                it->second += entry.second;
+            } else if (key_frequency.size() < max_distinct_keys) {
+                key_frequency.emplace(entry.first, entry.second);
+            } else {
+                untracked_keys += entry.second;
+            }
+        }
+    }
+};
+
+namespace detail {
+
+template <class DynamicType>
+void ProfileValue(const DynamicType& value, const std::uint64_t depth,
+                  const ProfileOptions& options, ShapeProfile& profile) {
+    profile.depths.Add(depth);
+
+    if (value.IsNull()) {
+        ++profile.nulls;
+    } else if (value.IsBoolean()) {
+        ++profile.booleans;
+    } else if (value.IsInteger()) {
+        ++profile.integers;
+    } else if (value.IsNumber()) {
+        ++profile.numbers;
+    } else if (value.IsString()) {
+        ++profile.strings;
+        profile.string_lengths.Add(value.GetString().size());
+    } else if (value.IsBlob()) {
+        ++profile.blobs;
+        profile.blob_lengths.Add(value.GetBlob().size());
+    } else if (value.IsStringView()) {
+        ++profile.string_views;
+        profile.string_lengths.Add(value.GetStringView().size());
+    } else if (value.IsBlobView()) {
+        ++profile.blob_views;
+        profile.blob_lengths.Add(value.GetBlobView().size());
+    } else if (value.IsArray()) {
+        const auto& array = value.GetArray();
+        ++profile.arrays;
+        profile.array_lengths.Add(array.size());
+        for (const auto& element : array) {
+            ProfileValue(element, depth + 1, options, profile);
+        }
+    } else if (value.IsObject()) {
+        const auto& object = value.GetObject();
+        ++profile.objects;
+        profile.object_sizes.Add(object.size());
+        for (const auto& entry : object) {
+            if (options.count_keys) {
+                const auto it = profile.key_frequency.find(entry.first);
+                if (it != profile.key_frequency.end()) {
+                    ++it->second;
+                } else if (profile.key_frequency.size() <
+                           options.max_distinct_keys) {
+                    profile.key_frequency.emplace(entry.first, 1);
+                } else {
+                    ++profile.untracked_keys;
+                }
+            }
+            ProfileValue(entry.second, depth + 1, options, profile);
+        }
+    } else {
+        ++profile.undefined;
+    }
+}
+
+}  // namespace detail
+
+// Adds one document to an existing profile.
+template <class DynamicType>
+void AddToProfile(const DynamicType& document, ShapeProfile& profile,
+                  const ProfileOptions& options = ProfileOptions{}) {
+    static_assert(detail::IsBasicDynamicSpecialization<DynamicType>::value,
+                  "Only BasicDynamic documents can be profiled");
+    ++profile.documents;
+    detail::ProfileValue(document, 0, options, profile);
+}
+
+template <class DynamicType>
+DNODISCARD ShapeProfile Profile(const DynamicType& document,
+                                const ProfileOptions& options =
+                                    ProfileOptions{}) {
+    ShapeProfile profile;
+    AddToProfile(document, profile, options);
+    return profile;
+}
+
+// Profiles one document in every `period`, so that it can sit on a hot path.
+// Not thread safe; use one sampler per thread and Merge() their profiles.
+class ProfileSampler {
+   public:
+    explicit ProfileSampler(const std::uint64_t period,
+                            const ProfileOptions& options = ProfileOptions{})
+        : period_(period == 0 ? 1 : period), options_(options) {}
+
+    // Returns whether the document was sampled.
+    template <class DynamicType>
+    bool Offer(const DynamicType& document) {
+        if (++seen_ % period_ != 0) {
+            return false;
+        }
+        AddToProfile(document, profile_, options_);
+        return true;
+    }
+
+    DNODISCARD std::uint64_t Seen() const noexcept { return seen_; }
+    DNODISCARD const ShapeProfile& GetProfile() const noexcept {
+        return profile_;
+    }
+
+    void Reset() {
+        seen_ = 0;
+        profile_ = ShapeProfile{};
+    }
+
+   private:
+    std::uint64_t period_;
+    ProfileOptions options_;
+    std::uint64_t seen_ = 0;
+    ShapeProfile profile_;
+};
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_PROFILE_H
@@ -0,0 +1,423 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Bounded lock-free queues for handing documents from one thread to another.
+//
+// SpscQueue connects one producer to one consumer; MpscQueue lets any number
+// of producers feed one consumer. Both are rings of a fixed, power-of-two
+// number of slots that values are moved into and out of; neither allocates
+// after construction, and neither ever blocks: a push to a full queue or a pop
+// from an empty one returns at once, leaving the caller to retry, back off or
+// drop.
+//
+// The batch operations move a run of values while touching the shared indices
+// only once, which is where most of the cost of a queue goes. When a type is
+// IsTriviallyRelocatable, such as DynamicManaged, popping moves its bytes out
+// of the slot instead of moving the value and destroying what is left.
+
+#ifndef DYNAMICXX_QUEUE_H
+#define DYNAMICXX_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+
+// Whether a value can be moved to another address by copying its bytes and
+// forgetting the original, without running its destructor. Specialize it for
+// types that are; it is never safe for a type that points into itself, as
+// some standard strings and hash maps do.
+template <class Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {};
+
+template <class Type>
+struct IsTriviallyRelocatable<std::shared_ptr<Type>> : std::true_type {};
+template <class Type>
+struct IsTriviallyRelocatable<std::unique_ptr<Type>> : std::true_type {};
+
+namespace detail {
+namespace queue {
+
+// Stands in for the private Impl of a BasicDynamic, so that the trait can ask
+// about the wrapper around it.
+struct ImplProbe {
+    ImplProbe(ImplProbe&&);
+    ~ImplProbe();
+};
+
+}  // namespace queue
+}  // namespace detail
+
+// A BasicDynamic is exactly its wrapper, so it relocates when the wrapper
+// does: a DynamicManaged is one pointer to a shared Impl, but a Dynamic holds
+// its payload inline.
+template <class IntegerType, class NumberType, class StringType,
+          template <class...> class BlobContainerType,
+          template <class...> class ArrayContainerType,
+          template <class...> class ObjectContainerType, class ToString,
+          class ToIndex, template <class...> class ImplWrapper>
+struct IsTriviallyRelocatable<
+    BasicDynamic<IntegerType, NumberType, StringType, BlobContainerType,
+                 ArrayContainerType, ObjectContainerType, ToString, ToIndex,
+                 ImplWrapper>>
+    : IsTriviallyRelocatable<ImplWrapper<detail::queue::ImplProbe>> {};
+
+namespace detail {
+namespace queue {
+
+// Keeps indices written by different threads on different cache lines.
+static constexpr std::size_t CacheLineSize = 64;
+
+inline std::size_t RoundUpCapacity(const std::size_t capacity) {
+    if (capacity == 0 || capacity > (~std::size_t{0} >> 2)) {
+        throw std::invalid_argument("Invalid queue capacity");
+    }
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+template <class Type>
+struct Storage {
+    alignas(Type) unsigned char bytes[sizeof(Type)];
+
+    Type& Get() noexcept { return *reinterpret_cast<Type*>(bytes); }
+};
+
+// Moves the value in `from` over `to`, and ends the lifetime of `from`.
+template <class Type>
+void RelocateOver(Type& to, Type& from, std::true_type) noexcept {
+    to.~Type();
+    std::memcpy(static_cast<void*>(std::addressof(to)),
+                static_cast<const void*>(std::addressof(from)), sizeof(Type));
+}
+template <class Type>
+void RelocateOver(Type& to, Type& from, std::false_type) {
+    to = std::move(from);
+    from.~Type();
+}
+template <class Type>
+void RelocateOver(Type& to, Type& from) {
+    RelocateOver(to, from, IsTriviallyRelocatable<Type>{});
+}
+
+}  // namespace queue
+}  // namespace detail
+
+// A bounded queue with one producer thread and one consumer thread. Only the
+// producer may push, and only the consumer may pop or call empty(); either may
+// call size(), which is approximate while the other is running.
+template <class Value>
+class SpscQueue {
+   public:
+    using value_type = Value;
+    using size_type = std::size_t;
+
+    // Holds at least `capacity` values; the capacity is rounded up to a power
+    // of two.
+    explicit SpscQueue(const size_type capacity)
+        : capacity_(detail::queue::RoundUpCapacity(capacity)),
+          mask_(capacity_ - 1),
+          slots_(new Slot[capacity_]) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue() {
+        const auto tail = tail_.load(std::memory_order_acquire);
+        for (auto head = head_.load(std::memory_order_relaxed); head != tail;
+             ++head) {
+            slots_[head & mask_].Get().~Value();
+        }
+    }
+
+    DNODISCARD size_type capacity() const noexcept { return capacity_; }
+    DNODISCARD size_type size() const noexcept {
+        return tail_.load(std::memory_order_acquire) -
+               head_.load(std::memory_order_acquire);
+    }
+    DNODISCARD bool empty() const noexcept { return size() == 0; }
+
+    // Constructs a value at the back of the queue from `args`. Returns false,
+    // constructing nothing, when the queue is full.
+    template <class... Args>
+    bool TryEmplace(Args&&... args) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (Free(tail, 1) == 0) {
+            return false;
+        }
+        new (slots_[tail & mask_].bytes) Value(std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    bool TryPush(Value&& value) { return TryEmplace(std::move(value)); }
+    bool TryPush(const Value& value) { return TryEmplace(value); }
+
+    // Moves values from `first` onwards into the queue, up to `count` of them
+    // or as many as fit. Returns the number moved.
+    template <class InputIt>
+    size_type TryPushBatch(InputIt first, const size_type count) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        const auto batch = Free(tail, count);
+        size_type pushed = 0;
+        try {
+            for (; pushed != batch; ++pushed, ++first) {
+                new (slots_[(tail + pushed) & mask_].bytes)
+                    Value(std::move(*first));
+            }
+        } catch (...) {
+            tail_.store(tail + pushed, std::memory_order_release);
+            throw;
+        }
+        tail_.store(tail + batch, std::memory_order_release);
+        return batch;
+    }
+
+    // Moves the value at the front of the queue into `out`. Returns false,
+    // leaving `out` alone, when the queue is empty.
+    bool TryPop(Value& out) {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (Ready(head, 1) == 0) {
+            return false;
+        }
+        detail::queue::RelocateOver(out, slots_[head & mask_].Get());
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Moves up to `max` values from the front of the queue to `out`, such as a
+    // std::back_inserter. Returns the number moved.
+    template <class OutputIt>
+    size_type TryPopBatch(OutputIt out, const size_type max) {
+        const auto head = head_.load(std::memory_order_relaxed);
+        const auto batch = Ready(head, max);
+        size_type popped = 0;
+        try {
+            for (; popped != batch; ++popped) {
+                auto& value = slots_[(head + popped) & mask_].Get();
+                *out = std::move(value);
+                ++out;
+                value.~Value();
+            }
+        } catch (...) {
+            slots_[(head + popped) & mask_].Get().~Value();
+            head_.store(head + popped + 1, std::memory_order_release);
+            throw;
+        }
+        head_.store(head + batch, std::memory_order_release);
+        return batch;
+    }
+
+   private:
+    using Slot = detail::queue::Storage<Value>;
+
+    // How many of `wanted` slots from `tail` are free. The consumer's index is
+    // only reloaded when the copy the producer last saw shows too few.
+    size_type Free(const size_type tail, const size_type wanted) noexcept {
+        auto free = capacity_ - (tail - cached_head_);
+        if (free < wanted) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free = capacity_ - (tail - cached_head_);
+        }
+        return free < wanted ? free : wanted;
+    }
+
+    // How many of `wanted` values from `head` are ready to pop.
+    size_type Ready(const size_type head, const size_type wanted) noexcept {
+        auto ready = cached_tail_ - head;
+        if (ready < wanted) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            ready = cached_tail_ - head;
+        }
+        return ready < wanted ? ready : wanted;
+    }
+
+    const size_type capacity_;
+    const size_type mask_;
+    const std::unique_ptr<Slot[]> slots_;
+
+    // Written by the producer.
+    alignas(detail::queue::CacheLineSize) std::atomic<size_type> tail_{0};
+    size_type cached_head_ = 0;
+
+    // Written by the consumer.
+    alignas(detail::queue::CacheLineSize) std::atomic<size_type> head_{0};
+    size_type cached_tail_ = 0;
+};
+
+// A bounded queue with any number of producer threads and one consumer thread.
+// Producers claim slots by advancing a shared index, then mark each slot ready
+// once its value is in place, so a slow producer delays only the values behind
+// its own.
+template <class Value>
+class MpscQueue {
+   public:
+    using value_type = Value;
+    using size_type = std::size_t;
+
+    explicit MpscQueue(const size_type capacity)
+        : capacity_(detail::queue::RoundUpCapacity(capacity)),
+          mask_(capacity_ - 1),
+          slots_(new Slot[capacity_]) {}
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // No producer may still be pushing.
+    ~MpscQueue() {
+        const auto tail = tail_.load(std::memory_order_acquire);
+        for (auto head = head_.load(std::memory_order_relaxed); head != tail;
+             ++head) {
+            slots_[head & mask_].storage.Get().~Value();
+        }
+    }
+
+    DNODISCARD size_type capacity() const noexcept { return capacity_; }
+    // Counts values still being written by their producers.
+    DNODISCARD size_type size() const noexcept {
+        return tail_.load(std::memory_order_acquire) -
+               head_.load(std::memory_order_acquire);
+    }
+    DNODISCARD bool empty() const noexcept { return size() == 0; }
+
+    template <class... Args>
+    bool TryEmplace(Args&&... args) {
+        size_type tail;
+        if (Claim(1, tail) == 0) {
+            return false;
+        }
+        Fill(tail, std::forward<Args>(args)...);
+        return true;
+    }
+    bool TryPush(Value&& value) { return TryEmplace(std::move(value)); }
+    bool TryPush(const Value& value) { return TryEmplace(value); }
+
+    // Claims up to `count` slots at once, so that the values from `first`
+    // onwards stay together in the queue. Returns the number moved. The slots
+    // are claimed before the values are moved in, so if moving one throws, it
+    // and the rest of the batch are pushed default-constructed.
+    template <class InputIt>
+    size_type TryPushBatch(InputIt first, const size_type count) {
+        size_type tail;
+        const auto batch = Claim(count, tail);
+        for (size_type i = 0; i != batch; ++i, ++first) {
+            try {
+                Fill(tail + i, std::move(*first));
+            } catch (...) {
+                Fill(tail + i);
+                for (++i; i != batch; ++i) {
+                    Fill(tail + i);
+                }
+                throw;
+            }
+        }
+        return batch;
+    }
+
+    // Consumer only.
+    bool TryPop(Value& out) {
+        const auto head = head_.load(std::memory_order_relaxed);
+        auto& slot = slots_[head & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+        detail::queue::RelocateOver(out, slot.storage.Get());
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Stops early at a slot that is claimed but not yet filled.
+    template <class OutputIt>
+    size_type TryPopBatch(OutputIt out, const size_type max) {
+        const auto head = head_.load(std::memory_order_relaxed);
+        size_type popped = 0;
+        try {
+            for (; popped != max; ++popped) {
+                auto& slot = slots_[(head + popped) & mask_];
+                if (slot.sequence.load(std::memory_order_acquire) !=
+                    head + popped + 1) {
+                    break;
+                }
+                *out = std::move(slot.storage.Get());
+                ++out;
+                slot.storage.Get().~Value();
+            }
+        } catch (...) {
+            slots_[(head + popped) & mask_].storage.Get().~Value();
+            head_.store(head + popped + 1, std::memory_order_release);
+            throw;
+        }
+        head_.store(head + popped, std::memory_order_release);
+        return popped;
+    }
+
+   private:
+    // `sequence` is one past the position of the value in the slot once it is
+    // ready, which no earlier use of the slot could have left there.
+    struct Slot {
+        std::atomic<size_type> sequence{0};
+        detail::queue::Storage<Value> storage;
+    };
+
+    // Claims up to `wanted` consecutive slots, the first at `tail`. The single
+    // consumer frees slots in order, so the space before its index is free.
+    size_type Claim(const size_type wanted, size_type& tail) noexcept {
+        tail = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            const auto head = head_.load(std::memory_order_acquire);
+            // A stale `tail` can be behind the consumer; the exchange below
+            // fails and refreshes it.
+            const auto used = tail - head;
+            const auto free = used > capacity_ ? 1 : capacity_ - used;
+            const auto batch = free < wanted ? free : wanted;
+            if (batch == 0) {
+                return 0;
+            }
+            if (tail_.compare_exchange_weak(tail, tail + batch,
+                                            std::memory_order_relaxed)) {
+                return batch;
+            }
+        }
+    }
+
+    template <class... Args>
+    void Fill(const size_type position, Args&&... args) {
+        auto& slot = slots_[position & mask_];
+        new (slot.storage.bytes) Value(std::forward<Args>(args)...);
+        slot.sequence.store(position + 1, std::memory_order_release);
+    }
+
+    const size_type capacity_;
+    const size_type mask_;
+    const std::unique_ptr<Slot[]> slots_;
+
+    alignas(detail::queue::CacheLineSize) std::atomic<size_type> tail_{0};
+    alignas(detail::queue::CacheLineSize) std::atomic<size_type> head_{0};
+};
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_QUEUE_H
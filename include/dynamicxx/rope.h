@@ -0,0 +1,467 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A rope: a string stored as a balanced tree of immutable chunks.
+//
+// Rope can replace std::string as the StringType of a BasicDynamic, for
+// values built up by many appends. Appending and concatenating are O(log n)
+// rather than a reallocation and copy of the whole text, copies share every
+// chunk, and Slice() shares the chunks it covers. Chunks() walks the text
+// without flattening it, e.g. to hand it to writev() or an ostream; Flatten(),
+// data() and c_str() flatten it, and so are not const.
+//
+// Ropes are persistent: operations never modify chunks that other ropes may
+// share, and nothing const modifies the rope itself, so a const Rope (or a
+// const document holding one) can be read from several threads at once.
+
+#ifndef DYNAMICXX_ROPE_H
+#define DYNAMICXX_ROPE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+
+template <class Char, class Traits = std::char_traits<Char>>
+class BasicRope {
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+   public:
+    using value_type = Char;               // NOLINT
+    using traits_type = Traits;            // NOLINT
+    using size_type = std::size_t;         // NOLINT
+    using Chunk = detail::StringView<Char>;
+
+    // Appending text shorter than this to a rope ending in a chunk shorter
+    // than this copies both into one chunk, so that building a rope out of
+    // many small pieces does not make a node per piece.
+    static constexpr std::size_t ShortChunkSize = 128;
+
+    BasicRope() noexcept = default;
+
+    BasicRope(const Char* text) : BasicRope(text, Traits::length(text)) {}
+
+    BasicRope(const Char* text, const std::size_t size)
+        : root_(MakeLeaf(text, size)) {}
+
+    // Takes over the storage of `text` without copying it.
+    BasicRope(std::basic_string<Char, Traits> text)
+        : root_(MakeLeaf(std::move(text))) {}
+
+    DNODISCARD std::size_t size() const noexcept {
+        return root_ ? root_->size : 0;
+    }
+    DNODISCARD std::size_t length() const noexcept { return size(); }
+    DNODISCARD bool empty() const noexcept { return size() == 0; }
+
+    // Number of chunks; 1 once flattened.
+    DNODISCARD std::size_t ChunkCount() const noexcept {
+        return root_ ? root_->chunks : 0;
+    }
+    DNODISCARD unsigned Height() const noexcept {
+        return root_ ? root_->height : 0;
+    }
+
+    BasicRope& Append(const BasicRope& that) {
+        root_ = Join(root_, that.root_);
+        return *this;
+    }
+    BasicRope& Append(const Char* text, const std::size_t size) {
+        root_ = Join(root_, MakeLeaf(text, size));
+        return *this;
+    }
+    BasicRope& Append(const Char* text) {
+        return Append(text, Traits::length(text));
+    }
+    BasicRope& Append(const std::basic_string<Char, Traits>& text) {
+        return Append(text.data(), text.size());
+    }
+
+    BasicRope& operator+=(const BasicRope& that) { return Append(that); }
+    BasicRope& operator+=(const Char* text) { return Append(text); }
+    BasicRope& operator+=(const std::basic_string<Char, Traits>& text) {
+        return Append(text);
+    }
+
+    DNODISCARD friend BasicRope operator+(BasicRope lhs,
+                                          const BasicRope& rhs) {
+        return lhs.Append(rhs);
+    }
+
+    // The characters [position, position + count), sharing this rope's
+    // chunks. A count reaching past the end is clamped to it.
+    DNODISCARD BasicRope Slice(const std::size_t position,
+                               std::size_t count = ~std::size_t{0}) const {
+        if (position > size()) {
+            throw std::out_of_range("Rope::Slice position out of range");
+        }
+        count = std::min(count, size() - position);
+        BasicRope slice;
+        slice.root_ = SliceOf(root_, position, count);
+        return slice;
+    }
+
+    // O(log n). Char() at or past the end, as std::string gives at size().
+    DNODISCARD Char operator[](std::size_t index) const noexcept {
+        if (index >= size()) {
+            return Char();
+        }
+        const Node* node = root_.get();
+        while (!node->IsLeaf()) {
+            if (index < node->left->size) {
+                node = node->left.get();
+            } else {
+                index -= node->left->size;
+                node = node->right.get();
+            }
+        }
+        return node->text.get()[index];
+    }
+    DNODISCARD Char at(const std::size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Rope::at index out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Copies the rope into a single, null terminated chunk, unless it is one
+    // already. Later appends build on the flattened chunk.
+    BasicRope& Flatten() {
+        if (root_ && !(root_->IsLeaf() && IsTerminated(*root_))) {
+            root_ = MakeLeaf(ToString());
+        }
+        return *this;
+    }
+
+    // Flattens the rope and returns its only chunk.
+    DNODISCARD const Char* data() {
+        Flatten();
+        return root_ ? root_->text.get() : EmptyText();
+    }
+    DNODISCARD const Char* c_str() { return data(); }
+
+    DNODISCARD std::basic_string<Char, Traits> ToString() const {
+        std::basic_string<Char, Traits> text;
+        text.reserve(size());
+        for (const auto& chunk : Chunks()) {
+            text.append(chunk.data(), chunk.size());
+        }
+        return text;
+    }
+
+    // Iterates over the chunks in order, each a view into the rope's storage.
+    class ChunkIterator {
+       public:
+        using value_type = Chunk;                           // NOLINT
+        using reference = Chunk;                            // NOLINT
+        using pointer = void;                               // NOLINT
+        using difference_type = std::ptrdiff_t;             // NOLINT
+        using iterator_category = std::input_iterator_tag;  // NOLINT
+
+        ChunkIterator() = default;
+        explicit ChunkIterator(const Node* root) {
+            if (root != nullptr) {
+                Descend(root);
+            }
+        }
+
+        DNODISCARD Chunk operator*() const {
+            const Node* leaf = path_.back();
+            return Chunk(leaf->text.get(), leaf->size);
+        }
+
+        ChunkIterator& operator++() {
+            path_.pop_back();
+            if (!path_.empty()) {
+                const Node* parent = path_.back();
+                path_.pop_back();
+                Descend(parent->right.get());
+            }
+            return *this;
+        }
+
+        DNODISCARD friend bool operator==(const ChunkIterator& lhs,
+                                          const ChunkIterator& rhs) noexcept {
+            if (lhs.path_.empty() || rhs.path_.empty()) {
+                return lhs.path_.empty() == rhs.path_.empty();
+            }
+            return lhs.path_.back() == rhs.path_.back();
+        }
+        DNODISCARD friend bool operator!=(const ChunkIterator& lhs,
+                                          const ChunkIterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+       private:
+        // Pushes the left spine of `node`. Internal nodes stay on the stack
+        // below their leftmost leaf until their right subtree is visited.
+        void Descend(const Node* node) {
+            while (!node->IsLeaf()) {
+                path_.push_back(node);
+                node = node->left.get();
+            }
+            path_.push_back(node);
+        }
+
+        std::vector<const Node*> path_;
+    };
+
+    class ChunkRange {
+       public:
+        explicit ChunkRange(const Node* root) noexcept : root_(root) {}
+        DNODISCARD ChunkIterator begin() const { return ChunkIterator(root_); }
+        DNODISCARD ChunkIterator end() const { return ChunkIterator(); }
+
+       private:
+        const Node* root_;
+    };
+
+    // The chunks must not outlive the rope, nor be used across a flatten.
+    DNODISCARD ChunkRange Chunks() const noexcept {
+        return ChunkRange(root_.get());
+    }
+
+    DNODISCARD int Compare(const BasicRope& that) const {
+        auto lhs = Chunks().begin();
+        auto rhs = that.Chunks().begin();
+        const ChunkIterator end;
+        std::size_t lhs_offset = 0;
+        std::size_t rhs_offset = 0;
+        while (lhs != end && rhs != end) {
+            const auto left = *lhs;
+            const auto right = *rhs;
+            const auto count = std::min(left.size() - lhs_offset,
+                                        right.size() - rhs_offset);
+            const auto order =
+                Traits::compare(left.data() + lhs_offset,
+                                right.data() + rhs_offset, count);
+            if (order != 0) {
+                return order;
+            }
+            lhs_offset += count;
+            rhs_offset += count;
+            if (lhs_offset == left.size()) {
+                ++lhs;
+                lhs_offset = 0;
+            }
+            if (rhs_offset == right.size()) {
+                ++rhs;
+                rhs_offset = 0;
+            }
+        }
+        if (size() == that.size()) {
+            return 0;
+        }
+        return size() < that.size() ? -1 : 1;
+    }
+
+    DNODISCARD friend bool operator==(const BasicRope& lhs,
+                                      const BasicRope& rhs) {
+        return lhs.size() == rhs.size() &&
+               (lhs.root_ == rhs.root_ || lhs.Compare(rhs) == 0);
+    }
+    DNODISCARD friend bool operator!=(const BasicRope& lhs,
+                                      const BasicRope& rhs) {
+        return !(lhs == rhs);
+    }
+    DNODISCARD friend bool operator==(const BasicRope& lhs, const Char* rhs) {
+        return lhs == BasicRope(rhs);
+    }
+    DNODISCARD friend bool operator<(const BasicRope& lhs,
+                                     const BasicRope& rhs) {
+        return lhs.Compare(rhs) < 0;
+    }
+
+    // Writes chunk by chunk, without flattening.
+    friend std::basic_ostream<Char, Traits>& operator<<(
+        std::basic_ostream<Char, Traits>& stream, const BasicRope& rope) {
+        for (const auto& chunk : rope.Chunks()) {
+            stream.write(chunk.data(),
+                         static_cast<std::streamsize>(chunk.size()));
+        }
+        return stream;
+    }
+
+   private:
+    // A leaf refers to `size` characters of a shared buffer through `text`;
+    // an internal node concatenates `left` and `right`.
+    struct Node {
+        std::size_t size = 0;
+        std::size_t chunks = 1;
+        unsigned height = 1;
+        NodePtr left;
+        NodePtr right;
+        std::shared_ptr<const Char> text;
+
+        DNODISCARD bool IsLeaf() const noexcept { return !left; }
+    };
+
+    static const Char* EmptyText() noexcept {
+        static const Char empty[1] = {};
+        return empty;
+    }
+
+    // Leaves are null terminated where they end their buffer, which lets a
+    // flattened rope serve c_str() without another copy.
+    static NodePtr MakeLeaf(std::basic_string<Char, Traits> text) {
+        if (text.empty()) {
+            return nullptr;
+        }
+        const auto buffer =
+            std::make_shared<const std::basic_string<Char, Traits>>(
+                std::move(text));
+        return MakeLeaf(std::shared_ptr<const Char>(buffer, buffer->data()),
+                        buffer->size());
+    }
+    static NodePtr MakeLeaf(const Char* text, const std::size_t size) {
+        if (size == 0) {
+            return nullptr;
+        }
+        return MakeLeaf(std::basic_string<Char, Traits>(text, size));
+    }
+    static NodePtr MakeLeaf(std::shared_ptr<const Char> text,
+                            const std::size_t size) {
+        auto node = std::make_shared<Node>();
+        node->size = size;
+        node->text = std::move(text);
+        return node;
+    }
+
+    static unsigned HeightOf(const NodePtr& node) noexcept {
+        return node ? node->height : 0;
+    }
+
+    static NodePtr MakeNode(NodePtr left, NodePtr right) {
+        auto node = std::make_shared<Node>();
+        node->size = left->size + right->size;
+        node->chunks = left->chunks + right->chunks;
+        node->height = std::max(left->height, right->height) + 1;
+        node->left = std::move(left);
+        node->right = std::move(right);
+        return node;
+    }
+
+    // Joins two balanced trees whose heights differ by at most two, with a
+    // single or double rotation as in an AVL tree.
+    static NodePtr Balance(const NodePtr& left, const NodePtr& right) {
+        const auto left_height = HeightOf(left);
+        const auto right_height = HeightOf(right);
+        if (left_height > right_height + 1) {
+            if (HeightOf(left->left) >= HeightOf(left->right)) {
+                return MakeNode(left->left, MakeNode(left->right, right));
+            }
+            return MakeNode(MakeNode(left->left, left->right->left),
+                            MakeNode(left->right->right, right));
+        }
+        if (right_height > left_height + 1) {
+            if (HeightOf(right->right) >= HeightOf(right->left)) {
+                return MakeNode(MakeNode(left, right->left), right->right);
+            }
+            return MakeNode(MakeNode(left, right->left->left),
+                            MakeNode(right->left->right, right->right));
+        }
+        return MakeNode(left, right);
+    }
+
+    // Concatenates two balanced trees in O(|height difference|): the shorter
+    // one is joined into the spine of the taller one, rebalancing on the way
+    // up.
+    static NodePtr Join(const NodePtr& left, const NodePtr& right) {
+        if (!left) {
+            return right;
+        }
+        if (!right) {
+            return left;
+        }
+        if (left->IsLeaf() && right->IsLeaf() &&
+            left->size < ShortChunkSize && right->size < ShortChunkSize) {
+            std::basic_string<Char, Traits> text;
+            text.reserve(left->size + right->size);
+            text.append(left->text.get(), left->size);
+            text.append(right->text.get(), right->size);
+            return MakeLeaf(std::move(text));
+        }
+        const auto left_height = HeightOf(left);
+        const auto right_height = HeightOf(right);
+        if (left_height > right_height + 1 ||
+            (!left->IsLeaf() && right->IsLeaf() &&
+             right->size < ShortChunkSize)) {
+            return Balance(left->left, Join(left->right, right));
+        }
+        if (right_height > left_height + 1) {
+            return Balance(Join(left, right->left), right->right);
+        }
+        return MakeNode(left, right);
+    }
+
+    static NodePtr SliceOf(const NodePtr& node, const std::size_t position,
+                           const std::size_t count) {
+        if (!node || count == 0) {
+            return nullptr;
+        }
+        if (position == 0 && count == node->size) {
+            return node;
+        }
+        if (node->IsLeaf()) {
+            return MakeLeaf(
+                std::shared_ptr<const Char>(node->text,
+                                            node->text.get() + position),
+                count);
+        }
+        const auto left_size = node->left->size;
+        if (position + count <= left_size) {
+            return SliceOf(node->left, position, count);
+        }
+        if (position >= left_size) {
+            return SliceOf(node->right, position - left_size, count);
+        }
+        return Join(SliceOf(node->left, position, left_size - position),
+                    SliceOf(node->right, 0, position + count - left_size));
+    }
+
+    // A leaf is only known to be null terminated if it is a whole buffer
+    // made by MakeLeaf(basic_string), so Flatten() copies slices too.
+    static bool IsTerminated(const Node& leaf) noexcept {
+        return Traits::eq(leaf.text.get()[leaf.size], Char());
+    }
+
+    NodePtr root_;
+};
+
+template <class Char, class Traits>
+constexpr std::size_t BasicRope<Char, Traits>::ShortChunkSize;
+
+using Rope = BasicRope<char>;
+
+// Dynamic, with strings that are ropes.
+using DynamicRope =
+    BasicDynamic<DefaultInteger, DefaultNumber, Rope, DefaultBlobContainer,
+                 DefaultArrayContainer, DefaultObjectContainer,
+                 DefaultToString, DefaultToIndex, detail::Just>;
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_ROPE_H
@@ -0,0 +1,400 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A reference counted, immutable blob container.
+//
+// SharedBlob can replace std::vector as the BlobContainerType of a
+// BasicDynamic. Copying one, and so copying or cloning a document holding one,
+// only bumps a reference count, and Slice() refers to a sub-range of the same
+// bytes. The bytes can be handed to scatter/gather I/O without copying.
+
+#ifndef DYNAMICXX_SHARED_BLOB_H
+#define DYNAMICXX_SHARED_BLOB_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+#define DYNAMICXX_HAS_IOVEC 1
+#define DYNAMICXX_HAS_MMAP 1
+#else
+#define DYNAMICXX_HAS_IOVEC 0
+#define DYNAMICXX_HAS_MMAP 0
+#endif
+
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+
+// A contiguous range of bytes to write, as taken by scatter/gather I/O.
+struct IoSlice {
+    const void* data;
+    std::size_t size;
+};
+
+namespace detail {
+
+// The number of bytes in [offset, offset + length) of a file of `file_size`
+// bytes; a length of ~0 means up to the end of the file.
+inline std::size_t CheckFileRange(const std::size_t file_size,
+                                  const std::size_t offset,
+                                  const std::size_t length) {
+    if (offset > file_size) {
+        throw std::out_of_range("File offset is past the end of the file");
+    }
+    const auto available = file_size - offset;
+    if (length == ~std::size_t{0}) {
+        return available;
+    }
+    if (length > available) {
+        throw std::out_of_range("File range is past the end of the file");
+    }
+    return length;
+}
+
+// Reads a range of a file into a resizable, contiguous container of bytes.
+template <class Container>
+Container ReadFileRange(const std::string& path, const std::size_t offset,
+                        const std::size_t length) {
+    static_assert(sizeof(typename Container::value_type) == 1,
+                  "Files are read as bytes");
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    const auto size = CheckFileRange(static_cast<std::size_t>(file.tellg()),
+                                     offset, length);
+    Container bytes(size);
+    file.seekg(static_cast<std::streamoff>(offset));
+    if (size != 0 && !file.read(reinterpret_cast<char*>(bytes.data()),
+                                static_cast<std::streamsize>(size))) {
+        throw std::runtime_error("Failed to read file: " + path);
+    }
+    return bytes;
+}
+
+}  // namespace detail
+
+#if DYNAMICXX_HAS_MMAP
+namespace detail {
+
+[[noreturn]] inline void ThrowSystemError(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+class FileDescriptor {
+   public:
+    explicit FileDescriptor(const char* path)
+        : descriptor_(::open(path, O_RDONLY | O_CLOEXEC)) {
+        if (descriptor_ < 0) {
+            ThrowSystemError("Failed to open file for mapping");
+        }
+    }
+    ~FileDescriptor() { ::close(descriptor_); }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    DNODISCARD int Get() const noexcept { return descriptor_; }
+
+   private:
+    int descriptor_;
+};
+
+// A read-only mapping, unmapped when the last blob referring to it is gone.
+class MappedRegion {
+   public:
+    MappedRegion(const int descriptor, const std::size_t offset,
+                 const std::size_t length) {
+        const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const auto aligned = offset - offset % page;
+        length_ = length + (offset - aligned);
+        base_ = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, descriptor,
+                       static_cast<off_t>(aligned));
+        if (base_ == MAP_FAILED) {
+            ThrowSystemError("Failed to map file");
+        }
+        data_ = static_cast<const unsigned char*>(base_) + (offset - aligned);
+    }
+    ~MappedRegion() { ::munmap(base_, length_); }
+
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+
+    DNODISCARD const void* Data() const noexcept { return data_; }
+
+   private:
+    void* base_;
+    std::size_t length_;
+    const void* data_;
+};
+
+}  // namespace detail
+#endif
+
+template <class Byte = std::uint8_t>
+class SharedBlob {
+   public:
+    using value_type = Byte;               // NOLINT
+    using size_type = std::size_t;         // NOLINT
+    using const_iterator = const Byte*;    // NOLINT
+    using iterator = const_iterator;       // NOLINT
+
+    SharedBlob() noexcept : data_(nullptr), size_(0) {}
+
+    SharedBlob(std::initializer_list<Byte> bytes)
+        : SharedBlob(std::vector<Byte>(bytes)) {}
+
+    // Copies [first, last) once; copies of the blob share the result.
+    template <class Iterator,
+              typename std::enable_if<
+                  !std::is_integral<Iterator>::value, int>::type = 0>
+    SharedBlob(Iterator first, Iterator last)
+        : SharedBlob(std::vector<Byte>(first, last)) {}
+
+    SharedBlob(const Byte* data, const std::size_t size)
+        : SharedBlob(data, data + size) {}
+
+    // Takes over the storage of `bytes` without copying it.
+    explicit SharedBlob(std::vector<Byte>&& bytes) : SharedBlob() {
+        if (bytes.empty()) {
+            return;
+        }
+        const auto holder =
+            std::make_shared<const std::vector<Byte>>(std::move(bytes));
+        size_ = holder->size();
+        data_ = std::shared_ptr<const Byte>(holder, holder->data());
+    }
+
+    // Wraps bytes owned elsewhere, such as a memory mapping. `owner` keeps
+    // them alive and releases them when the last copy of the blob goes away.
+    template <class Owner>
+    DNODISCARD static SharedBlob Adopt(const std::shared_ptr<Owner>& owner,
+                                       const Byte* data,
+                                       const std::size_t size) noexcept {
+        return SharedBlob(std::shared_ptr<const Byte>(owner, data), size);
+    }
+
+    // Maps `length` bytes of the file at `path`, starting at byte `offset`, or
+    // up to its end when `length` is omitted. The pages are shared with the
+    // page cache instead of being copied to the heap, and are unmapped when
+    // the last copy or slice of the blob goes away. The file should not be
+    // truncated while mapped. Where mmap is unavailable, the range is read.
+    //
+    // Throws std::out_of_range if the range is not within the file, and
+    // std::runtime_error (a std::system_error where mmap is used) if the file
+    // cannot be opened, mapped or read.
+    DNODISCARD static SharedBlob FromFile(
+        const std::string& path, const std::size_t offset = 0,
+        const std::size_t length = ~std::size_t{0}) {
+        static_assert(sizeof(Byte) == 1, "Files are mapped as bytes");
+#if DYNAMICXX_HAS_MMAP
+        const detail::FileDescriptor file(path.c_str());
+        struct stat status;
+        if (::fstat(file.Get(), &status) != 0) {
+            detail::ThrowSystemError("Failed to stat file for mapping");
+        }
+        const auto size = detail::CheckFileRange(
+            static_cast<std::size_t>(status.st_size), offset, length);
+        if (size == 0) {
+            return SharedBlob();
+        }
+        const auto region =
+            std::make_shared<detail::MappedRegion>(file.Get(), offset, size);
+        return Adopt(region, static_cast<const Byte*>(region->Data()), size);
+#else
+        return SharedBlob(
+            detail::ReadFileRange<std::vector<Byte>>(path, offset, length));
+#endif
+    }
+
+    DNODISCARD const Byte* data() const noexcept { return data_.get(); }
+    DNODISCARD std::size_t size() const noexcept { return size_; }
+    DNODISCARD bool empty() const noexcept { return size_ == 0; }
+
+    DNODISCARD const_iterator begin() const noexcept { return data(); }
+    DNODISCARD const_iterator end() const noexcept { return data() + size_; }
+
+    DNODISCARD const Byte& operator[](const std::size_t index) const noexcept {
+        return data()[index];
+    }
+
+    // The bytes [offset, offset + length), sharing this blob's storage. A
+    // length reaching past the end is clamped to it.
+    DNODISCARD SharedBlob Slice(const std::size_t offset,
+                                std::size_t length = ~std::size_t{0}) const {
+        if (offset > size_) {
+            throw std::out_of_range("SharedBlob::Slice offset out of range");
+        }
+        if (length > size_ - offset) {
+            length = size_ - offset;
+        }
+        return SharedBlob(std::shared_ptr<const Byte>(data_, data() + offset),
+                          length);
+    }
+
+    // Number of blobs sharing this storage, this one included.
+    DNODISCARD long UseCount() const noexcept { return data_.use_count(); }
+
+    // Whether `that` refers to the same bytes, rather than equal ones.
+    DNODISCARD bool SharesWith(const SharedBlob& that) const noexcept {
+        return data() == that.data() && size_ == that.size_;
+    }
+
+    DNODISCARD IoSlice AsIoSlice() const noexcept {
+        return IoSlice{data(), size_ * sizeof(Byte)};
+    }
+#if DYNAMICXX_HAS_IOVEC
+    DNODISCARD struct iovec AsIovec() const noexcept {
+        struct iovec vector;
+        vector.iov_base = const_cast<Byte*>(data());
+        vector.iov_len = size_ * sizeof(Byte);
+        return vector;
+    }
+#endif
+
+    DNODISCARD friend bool operator==(const SharedBlob& lhs,
+                                      const SharedBlob& rhs) noexcept {
+        if (lhs.size_ != rhs.size_) {
+            return false;
+        }
+        if (lhs.data() == rhs.data()) {
+            return true;
+        }
+        for (std::size_t i = 0; i < lhs.size_; ++i) {
+            if (!(lhs[i] == rhs[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    DNODISCARD friend bool operator!=(const SharedBlob& lhs,
+                                      const SharedBlob& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+   private:
+    SharedBlob(std::shared_ptr<const Byte> data,
+               const std::size_t size) noexcept
+        : data_(std::move(data)), size_(size) {}
+
+    std::shared_ptr<const Byte> data_;
+    std::size_t size_;
+};
+
+// Appends the I/O slices of every blob in `value`, in document order, so that a
+// whole envelope's payloads can go to one writev() without being copied.
+// Views are included too; the buffers they point into must stay alive.
+template <class DynamicType>
+void CollectIoSlices(const DynamicType& value, std::vector<IoSlice>& slices) {
+    if (value.IsBlob() || value.IsBlobView()) {
+        const auto view = value.ToBlobView();
+        if (!view.empty()) {
+            slices.push_back(IoSlice{
+                view.data(),
+                view.size() * sizeof(typename DynamicType::Blob::value_type)});
+        }
+    } else if (value.IsArray()) {
+        for (const auto& element : value.GetArray()) {
+            CollectIoSlices(element, slices);
+        }
+    } else if (value.IsObject()) {
+        for (const auto& entry : value.GetObject()) {
+            CollectIoSlices(entry.second, slices);
+        }
+    }
+}
+
+namespace detail {
+
+struct HasFromFileImpl {
+    template <class T>
+    static AlwaysTrueType<decltype(T::FromFile(std::declval<std::string>(), 0,
+                                               0))>
+    test(void*);
+
+    template <class T>
+    static std::false_type test(...);
+};
+
+template <class T>
+constexpr bool HasFromFile() noexcept {
+    return decltype(HasFromFileImpl::template test<T>(nullptr))::value;
+}
+
+template <class Container, bool = HasFromFile<Container>()>
+struct LoadFileRange;
+
+// Containers that can map a file themselves, such as SharedBlob.
+template <class Container>
+struct LoadFileRange<Container, true> {
+    Container operator()(const std::string& path, const std::size_t offset,
+                         const std::size_t length) const {
+        return Container::FromFile(path, offset, length);
+    }
+};
+template <class Container>
+struct LoadFileRange<Container, false> {
+    Container operator()(const std::string& path, const std::size_t offset,
+                         const std::size_t length) const {
+        return ReadFileRange<Container>(path, offset, length);
+    }
+};
+
+}  // namespace detail
+
+// A Blob value holding `length` bytes of the file at `path` from byte
+// `offset`, or everything after it when `length` is omitted. Blob containers
+// with a FromFile() factory, such as SharedBlob, map the file instead of
+// reading it.
+template <class DynamicType>
+DNODISCARD DynamicType BlobFromFile(
+    const std::string& path, const std::size_t offset = 0,
+    const std::size_t length = ~std::size_t{0}) {
+    using Blob = typename DynamicType::Blob;
+    return DynamicType::template From<Blob>(
+        detail::LoadFileRange<Blob>{}(path, offset, length));
+}
+
+template <class... Ts>
+using SharedBlobContainer = SharedBlob<Ts...>;
+
+// Dynamic, with blobs that are shared rather than copied.
+using DynamicSharedBlob =
+    BasicDynamic<DefaultInteger, DefaultNumber, DefaultString,
+                 SharedBlobContainer, DefaultArrayContainer,
+                 DefaultObjectContainer, DefaultToString, DefaultToIndex,
+                 detail::Just>;
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_SHARED_BLOB_H
@@ -0,0 +1,681 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Documents that other processes read in place, without deserializing them.
+//
+// Freeze() writes a document into a segment of memory, such as a POSIX shared
+// memory object mapped with SharedMemory, through a SegmentArena. Every
+// pointer in the frozen document is an OffsetPtr, relative to its own address,
+// so the segment can be mapped at a different address in each process.
+// Object keys are sorted, so that readers find them by binary search. A
+// SharedValue navigates the frozen document, and Thaw() copies it back into a
+// BasicDynamic.
+//
+// A segment is written by one process and then published with
+// SegmentArena::Publish(); readers must not look at it before then, and the
+// writer must not change it after. To exchange a stream of states, write each
+// one to a fresh segment. Nothing here tracks readers, so a segment may only
+// be reformatted once the application knows that no reader still holds a
+// SharedValue into it; reusing it any earlier gives readers torn values. The
+// processes must agree on the layout of the frozen values, so they need the
+// same architecture and version of this header. Readers trust the writer:
+// offsets are not bounds checked.
+
+#ifndef DYNAMICXX_SHARED_MEMORY_H
+#define DYNAMICXX_SHARED_MEMORY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dynamicxx/dynamicxx.h"
+#include "dynamicxx/shared_blob.h"
+
+namespace dynamicxx {
+
+// A pointer stored as the distance from its own address to its target, so that
+// it stays valid wherever the memory holding both is mapped. Copying one
+// re-bases the offset on the copy's address. A distance of 1 means null; 0
+// would be a pointer to itself.
+template <class Type>
+class OffsetPtr {
+   public:
+    using element_type = Type;
+
+    OffsetPtr() noexcept = default;
+    OffsetPtr(Type* pointer) noexcept { Set(pointer); }  // NOLINT
+    OffsetPtr(const OffsetPtr& that) noexcept { Set(that.get()); }
+
+    OffsetPtr& operator=(const OffsetPtr& that) noexcept {
+        Set(that.get());
+        return *this;
+    }
+    OffsetPtr& operator=(Type* pointer) noexcept {
+        Set(pointer);
+        return *this;
+    }
+
+    DNODISCARD Type* get() const noexcept {
+        if (offset_ == 1) {
+            return nullptr;
+        }
+        return reinterpret_cast<Type*>(Address() + offset_);
+    }
+
+    DNODISCARD Type& operator*() const noexcept { return *get(); }
+    DNODISCARD Type* operator->() const noexcept { return get(); }
+    DNODISCARD Type& operator[](const std::size_t index) const noexcept {
+        return get()[index];
+    }
+    explicit operator bool() const noexcept { return offset_ != 1; }
+
+    DNODISCARD friend bool operator==(const OffsetPtr& lhs,
+                                      const OffsetPtr& rhs) noexcept {
+        return lhs.get() == rhs.get();
+    }
+    DNODISCARD friend bool operator!=(const OffsetPtr& lhs,
+                                      const OffsetPtr& rhs) noexcept {
+        return lhs.get() != rhs.get();
+    }
+
+   private:
+    std::intptr_t Address() const noexcept {
+        return reinterpret_cast<std::intptr_t>(this);
+    }
+
+    void Set(Type* pointer) noexcept {
+        offset_ = pointer == nullptr
+                      ? 1
+                      : static_cast<std::int64_t>(
+                            reinterpret_cast<std::intptr_t>(pointer) -
+                            Address());
+    }
+
+    std::int64_t offset_ = 1;
+};
+
+namespace detail {
+namespace shm {
+
+enum struct Kind : std::uint8_t {
+    Null = 0,
+    Boolean,
+    Integer,
+    Number,
+    String,
+    Blob,
+    Array,
+    Object,
+    Undefined,
+};
+
+struct Entry;
+
+// A frozen value. `size` and `data` describe strings and blobs (bytes), arrays
+// (Nodes) and objects (Entries sorted by key).
+struct Node {
+    Kind kind = Kind::Undefined;
+    bool boolean = false;
+    std::uint64_t size = 0;
+    union {
+        std::int64_t integer;
+        double number;
+    };
+    OffsetPtr<const unsigned char> data;
+
+    Node() noexcept : integer(0) {}
+
+    const Node* Elements() const noexcept {
+        return reinterpret_cast<const Node*>(data.get());
+    }
+    const Entry* Entries() const noexcept {
+        return reinterpret_cast<const Entry*>(data.get());
+    }
+};
+
+struct Entry {
+    OffsetPtr<const char> key;
+    std::uint64_t key_size = 0;
+    Node value;
+};
+
+constexpr std::uint64_t Magic = 0x31304D4853585844U;  // "DXXSHM01"
+constexpr std::uint32_t Version = 1;
+
+// The start of every segment.
+struct Header {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t node_size;
+    std::uint64_t capacity;
+    // Offset of the published root Node from the start of the segment, or 0.
+    std::atomic<std::uint64_t> root;
+};
+
+#if defined(ATOMIC_LLONG_LOCK_FREE)
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "Shared segments need address-free 64-bit atomics");
+#endif
+
+inline int CompareKeys(const char* lhs, const std::size_t lhs_size,
+                       const char* rhs, const std::size_t rhs_size) noexcept {
+    const auto common = std::min(lhs_size, rhs_size);
+    const int result = common == 0 ? 0 : std::memcmp(lhs, rhs, common);
+    if (result != 0) {
+        return result;
+    }
+    return lhs_size < rhs_size ? -1 : lhs_size > rhs_size ? 1 : 0;
+}
+
+}  // namespace shm
+}  // namespace detail
+
+class SharedValue;
+
+// Hands out memory from a segment in order, for Freeze() to write a document
+// into. Nothing is freed; the segment is reused by formatting it again.
+class SegmentArena {
+   public:
+    // Formats [base, base + capacity) as an empty segment. `base` must be
+    // aligned for a std::uint64_t.
+    SegmentArena(void* base, const std::size_t capacity)
+        : base_(static_cast<unsigned char*>(base)),
+          capacity_(capacity),
+          used_(sizeof(detail::shm::Header)) {
+        if (capacity < sizeof(detail::shm::Header)) {
+            throw std::invalid_argument("Segment is too small for a header");
+        }
+        auto* header = new (base_) detail::shm::Header;
+        header->magic = detail::shm::Magic;
+        header->version = detail::shm::Version;
+        header->node_size = sizeof(detail::shm::Node);
+        header->capacity = capacity;
+        header->root.store(0, std::memory_order_relaxed);
+    }
+
+    SegmentArena(const SegmentArena&) = delete;
+    SegmentArena& operator=(const SegmentArena&) = delete;
+
+    // Throws std::bad_alloc when the segment is full.
+    DNODISCARD void* Allocate(const std::size_t size,
+                              const std::size_t alignment) {
+        const auto start = (used_ + alignment - 1) & ~(alignment - 1);
+        if (start > capacity_ || size > capacity_ - start) {
+            throw std::bad_alloc();
+        }
+        used_ = start + size;
+        return base_ + start;
+    }
+
+    // Makes `root`, which must have been frozen into this arena, the document
+    // that readers of the segment see. Everything written before is visible
+    // to a reader that sees it.
+    void Publish(const SharedValue& root) noexcept;
+
+    DNODISCARD void* Base() const noexcept { return base_; }
+    DNODISCARD std::size_t Used() const noexcept { return used_; }
+    DNODISCARD std::size_t Capacity() const noexcept { return capacity_; }
+
+   private:
+    detail::shm::Header& GetHeader() const noexcept {
+        return *reinterpret_cast<detail::shm::Header*>(base_);
+    }
+
+    unsigned char* base_;
+    std::size_t capacity_;
+    std::size_t used_;
+};
+
+// A read-only view of a value frozen into a segment. Access has the same
+// shape as BasicDynamic's, and throws InvalidAccessException on a value of
+// the wrong type.
+class SharedValue {
+   public:
+    using StringView = detail::StringView<char>;
+    using BlobView = detail::BlobView<std::uint8_t>;
+
+    DNODISCARD bool IsNull() const noexcept { return Is(Kind::Null); }
+    DNODISCARD bool IsBoolean() const noexcept { return Is(Kind::Boolean); }
+    DNODISCARD bool IsInteger() const noexcept { return Is(Kind::Integer); }
+    DNODISCARD bool IsNumber() const noexcept { return Is(Kind::Number); }
+    DNODISCARD bool IsString() const noexcept { return Is(Kind::String); }
+    DNODISCARD bool IsBlob() const noexcept { return Is(Kind::Blob); }
+    DNODISCARD bool IsArray() const noexcept { return Is(Kind::Array); }
+    DNODISCARD bool IsObject() const noexcept { return Is(Kind::Object); }
+    DNODISCARD bool IsUndefined() const noexcept {
+        return Is(Kind::Undefined);
+    }
+
+    DNODISCARD bool GetBoolean() const {
+        Expect(Kind::Boolean);
+        return node_->boolean;
+    }
+    DNODISCARD std::int64_t GetInteger() const {
+        Expect(Kind::Integer);
+        return node_->integer;
+    }
+    DNODISCARD double GetNumber() const {
+        Expect(Kind::Number);
+        return node_->number;
+    }
+    // Points into the segment.
+    DNODISCARD StringView GetString() const {
+        Expect(Kind::String);
+        return StringView(reinterpret_cast<const char*>(node_->data.get()),
+                          static_cast<std::size_t>(node_->size));
+    }
+    DNODISCARD BlobView GetBlob() const {
+        Expect(Kind::Blob);
+        return BlobView(node_->data.get(),
+                        static_cast<std::size_t>(node_->size));
+    }
+
+    // Elements of an array, entries of an object, or bytes of a string or
+    // blob.
+    DNODISCARD std::size_t size() const noexcept {
+        return static_cast<std::size_t>(node_->size);
+    }
+
+    // An array element, or an object value, as for BasicDynamic::operator[].
+    // Throws std::out_of_range if there is no such element or key.
+    template <class Key>
+    DNODISCARD SharedValue operator[](const Key& key) const {
+        if (IsArray()) {
+            return AtIndex(DefaultToIndex{}.Convert(key));
+        } else if (IsObject()) {
+            return AtKey(StringView(
+                DefaultToString{}.template Convert<std::string>(key)));
+        }
+        throw InvalidAccessException("Invalid access attempted");
+    }
+
+    DNODISCARD bool Contains(const StringView key) const {
+        Expect(Kind::Object);
+        return Find(key) != nullptr;
+    }
+
+    // The key and value of the index-th entry of an object, in key order.
+    DNODISCARD StringView KeyAt(const std::size_t index) const {
+        const auto& entry = EntryAt(index);
+        return StringView(entry.key.get(),
+                          static_cast<std::size_t>(entry.key_size));
+    }
+    DNODISCARD SharedValue ValueAt(const std::size_t index) const {
+        return SharedValue(&EntryAt(index).value);
+    }
+
+    // Copies the value out of the segment.
+    template <class DynamicType>
+    DNODISCARD DynamicType Thaw() const {
+        switch (node_->kind) {
+            case Kind::Null:
+                return DynamicType::template From<typename DynamicType::Null>();
+            case Kind::Boolean:
+                return DynamicType::template From<
+                    typename DynamicType::Boolean>(node_->boolean);
+            case Kind::Integer:
+                return DynamicType::template From<
+                    typename DynamicType::Integer>(node_->integer);
+            case Kind::Number:
+                return DynamicType::template From<
+                    typename DynamicType::Number>(node_->number);
+            case Kind::String: {
+                const auto view = GetString();
+                typename DynamicType::String string(view.data(), view.size());
+                return DynamicType::template From<
+                    typename DynamicType::String>(std::move(string));
+            }
+            case Kind::Blob: {
+                using Byte = typename DynamicType::Blob::value_type;
+                const auto view = GetBlob();
+                const auto* bytes = reinterpret_cast<const Byte*>(view.data());
+                typename DynamicType::Blob blob(bytes, bytes + view.size());
+                return DynamicType::template From<typename DynamicType::Blob>(
+                    std::move(blob));
+            }
+            case Kind::Array: {
+                auto array = DynamicType::template From<
+                    typename DynamicType::Array>();
+                auto& elements = array.GetArray();
+                detail::reserve(elements, size());
+                for (std::size_t i = 0; i < size(); ++i) {
+                    elements.push_back(
+                        SharedValue(node_->Elements() + i)
+                            .template Thaw<DynamicType>());
+                }
+                return array;
+            }
+            case Kind::Object: {
+                typename DynamicType::ObjectBuilder builder;
+                builder.Reserve(size());
+                for (std::size_t i = 0; i < size(); ++i) {
+                    const auto key = KeyAt(i);
+                    builder.Add(std::string(key.data(), key.size()),
+                                ValueAt(i).template Thaw<DynamicType>());
+                }
+                return builder.Finish();
+            }
+            default:
+                return DynamicType();
+        }
+    }
+
+   private:
+    using Kind = detail::shm::Kind;
+
+    explicit SharedValue(const detail::shm::Node* node) noexcept
+        : node_(node) {}
+
+    bool Is(const Kind kind) const noexcept { return node_->kind == kind; }
+    void Expect(const Kind kind) const {
+        if (!Is(kind)) {
+            UNLIKELY {
+                throw InvalidAccessException("Invalid access attempted");
+            }
+        }
+    }
+
+    SharedValue AtIndex(const std::size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("SharedValue index out of range");
+        }
+        return SharedValue(node_->Elements() + index);
+    }
+
+    SharedValue AtKey(const StringView key) const {
+        const auto* node = Find(key);
+        if (node == nullptr) {
+            throw std::out_of_range("SharedValue key not found");
+        }
+        return SharedValue(node);
+    }
+
+    const detail::shm::Entry& EntryAt(const std::size_t index) const {
+        Expect(Kind::Object);
+        if (index >= size()) {
+            throw std::out_of_range("SharedValue index out of range");
+        }
+        return node_->Entries()[index];
+    }
+
+    const detail::shm::Node* Find(const StringView key) const noexcept {
+        const auto* entries = node_->Entries();
+        std::size_t low = 0;
+        std::size_t high = size();
+        while (low < high) {
+            const auto middle = low + (high - low) / 2;
+            const auto& entry = entries[middle];
+            const int order = detail::shm::CompareKeys(
+                entry.key.get(), static_cast<std::size_t>(entry.key_size),
+                key.data(), key.size());
+            if (order == 0) {
+                return &entry.value;
+            }
+            if (order < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return nullptr;
+    }
+
+    const detail::shm::Node* node_;
+
+    friend class SegmentArena;
+    template <class DynamicType>
+    friend SharedValue Freeze(const DynamicType& value, SegmentArena& arena);
+    friend SharedValue ReadSegment(const void* base, std::size_t size);
+};
+
+inline void SegmentArena::Publish(const SharedValue& root) noexcept {
+    const auto offset =
+        reinterpret_cast<const unsigned char*>(root.node_) - base_;
+    GetHeader().root.store(static_cast<std::uint64_t>(offset),
+                           std::memory_order_release);
+}
+
+namespace detail {
+namespace shm {
+
+inline const unsigned char* CopyBytes(SegmentArena& arena, const void* data,
+                                      const std::size_t size) {
+    if (size == 0) {
+        return nullptr;
+    }
+    auto* copy = static_cast<unsigned char*>(arena.Allocate(size, 1));
+    std::memcpy(copy, data, size);
+    return copy;
+}
+
+template <class DynamicType>
+void FreezeInto(Node& node, const DynamicType& value, SegmentArena& arena) {
+    if (value.IsNull()) {
+        node.kind = Kind::Null;
+    } else if (value.IsBoolean()) {
+        node.kind = Kind::Boolean;
+        node.boolean = value.GetBoolean();
+    } else if (value.IsInteger()) {
+        node.kind = Kind::Integer;
+        node.integer = static_cast<std::int64_t>(value.GetInteger());
+    } else if (value.IsNumber()) {
+        node.kind = Kind::Number;
+        node.number = static_cast<double>(value.GetNumber());
+    } else if (value.IsString() || value.IsStringView()) {
+        // Frozen documents own their bytes, so views are copied.
+        using Char = typename DynamicType::String::value_type;
+        const auto copy = [&node, &arena](const Char* data,
+                                          const std::size_t size) {
+            node.size = size;
+            node.data = CopyBytes(arena, data, size);
+        };
+        node.kind = Kind::String;
+        if (value.IsString()) {
+            detail::WithContiguous(value.GetString(), copy);
+        } else {
+            copy(value.GetStringView().data(), value.GetStringView().size());
+        }
+    } else if (value.IsBlob() || value.IsBlobView()) {
+        const auto view = value.IsBlob() ? typename DynamicType::BlobView(
+                                               value.GetBlob().data(),
+                                               value.GetBlob().size())
+                                         : value.GetBlobView();
+        node.kind = Kind::Blob;
+        node.size = view.size();
+        node.data = CopyBytes(arena, view.data(),
+                              view.size() * sizeof(*view.data()));
+    } else if (value.IsArray()) {
+        const auto& array = value.GetArray();
+        auto* elements = static_cast<Node*>(
+            arena.Allocate(array.size() * sizeof(Node), alignof(Node)));
+        std::size_t i = 0;
+        for (const auto& element : array) {
+            FreezeInto(*new (elements + i++) Node, element, arena);
+        }
+        node.kind = Kind::Array;
+        node.size = array.size();
+        node.data = array.empty()
+                        ? nullptr
+                        : reinterpret_cast<const unsigned char*>(elements);
+    } else if (value.IsObject()) {
+        using Member = std::pair<const std::string*, const DynamicType*>;
+        std::vector<Member> members;
+        members.reserve(value.size());
+        for (const auto& entry : value.GetObject()) {
+            members.emplace_back(&entry.first, &entry.second);
+        }
+        std::sort(members.begin(), members.end(),
+                  [](const Member& lhs, const Member& rhs) {
+                      return *lhs.first < *rhs.first;
+                  });
+        auto* entries = static_cast<Entry*>(
+            arena.Allocate(members.size() * sizeof(Entry), alignof(Entry)));
+        for (std::size_t i = 0; i < members.size(); ++i) {
+            auto* entry = new (entries + i) Entry;
+            const auto& key = *members[i].first;
+            entry->key = reinterpret_cast<const char*>(
+                CopyBytes(arena, key.data(), key.size()));
+            entry->key_size = key.size();
+            FreezeInto(entry->value, *members[i].second, arena);
+        }
+        node.kind = Kind::Object;
+        node.size = members.size();
+        node.data = members.empty()
+                        ? nullptr
+                        : reinterpret_cast<const unsigned char*>(entries);
+    } else {
+        node.kind = Kind::Undefined;
+    }
+}
+
+}  // namespace shm
+}  // namespace detail
+
+// Writes `value` into the arena, and returns a view of the frozen copy, for
+// SegmentArena::Publish(). Throws std::bad_alloc if it does not fit.
+template <class DynamicType>
+DNODISCARD SharedValue Freeze(const DynamicType& value, SegmentArena& arena) {
+    static_assert(std::is_integral<typename DynamicType::Integer>::value,
+                  "Only built-in integers can be frozen");
+    static_assert(std::is_floating_point<typename DynamicType::Number>::value,
+                  "Only built-in numbers can be frozen");
+    static_assert(sizeof(typename DynamicType::String::value_type) == 1,
+                  "Only strings of bytes can be frozen");
+    using detail::shm::Node;
+    auto* root = new (arena.Allocate(sizeof(Node), alignof(Node))) Node;
+    detail::shm::FreezeInto(*root, value, arena);
+    return SharedValue(root);
+}
+
+// The document published in the segment at `base`. Throws std::runtime_error
+// if the segment was not written by a compatible SegmentArena, or nothing has
+// been published yet.
+DNODISCARD inline SharedValue ReadSegment(const void* base,
+                                          const std::size_t size) {
+    const auto* header = static_cast<const detail::shm::Header*>(base);
+    if (size < sizeof(detail::shm::Header) ||
+        header->magic != detail::shm::Magic ||
+        header->version != detail::shm::Version ||
+        header->node_size != sizeof(detail::shm::Node) ||
+        header->capacity > size) {
+        throw std::runtime_error("Not a compatible dynamicxx segment");
+    }
+    const auto root = header->root.load(std::memory_order_acquire);
+    if (root == 0) {
+        throw std::runtime_error("No document published in the segment");
+    }
+    return SharedValue(reinterpret_cast<const detail::shm::Node*>(
+        static_cast<const unsigned char*>(base) + root));
+}
+
+#if DYNAMICXX_HAS_MMAP
+// A POSIX shared memory object, mapped for the lifetime of this handle.
+class SharedMemory {
+   public:
+    // Creates the object `name` (such as "/state"), which must not exist, with
+    // `size` zeroed bytes, and maps it for writing. Throws std::system_error.
+    DNODISCARD static SharedMemory Create(const std::string& name,
+                                          const std::size_t size) {
+        const int descriptor = ::shm_open(
+            name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (descriptor < 0) {
+            detail::ThrowSystemError("Failed to create shared memory");
+        }
+        if (::ftruncate(descriptor, static_cast<off_t>(size)) != 0) {
+            const int error = errno;
+            ::close(descriptor);
+            ::shm_unlink(name.c_str());
+            errno = error;
+            detail::ThrowSystemError("Failed to size shared memory");
+        }
+        return SharedMemory(descriptor, size, PROT_READ | PROT_WRITE);
+    }
+
+    // Maps the existing object `name` for reading. Throws std::system_error.
+    DNODISCARD static SharedMemory Open(const std::string& name) {
+        const int descriptor =
+            ::shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+        if (descriptor < 0) {
+            detail::ThrowSystemError("Failed to open shared memory");
+        }
+        struct stat status;
+        if (::fstat(descriptor, &status) != 0) {
+            const int error = errno;
+            ::close(descriptor);
+            errno = error;
+            detail::ThrowSystemError("Failed to stat shared memory");
+        }
+        return SharedMemory(descriptor,
+                            static_cast<std::size_t>(status.st_size),
+                            PROT_READ);
+    }
+
+    // Removes the name; mappings stay valid until they are unmapped.
+    static void Unlink(const std::string& name) noexcept {
+        ::shm_unlink(name.c_str());
+    }
+
+    SharedMemory(SharedMemory&& that) noexcept
+        : data_(that.data_), size_(that.size_) {
+        that.data_ = nullptr;
+        that.size_ = 0;
+    }
+    SharedMemory& operator=(SharedMemory&& that) noexcept {
+        std::swap(data_, that.data_);
+        std::swap(size_, that.size_);
+        return *this;
+    }
+    ~SharedMemory() {
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+        }
+    }
+
+    DNODISCARD void* Data() const noexcept { return data_; }
+    DNODISCARD std::size_t size() const noexcept { return size_; }
+
+   private:
+    // Takes ownership of `descriptor`, which is closed once mapped.
+    SharedMemory(const int descriptor, const std::size_t size,
+                 const int protection)
+        : size_(size) {
+        data_ = size == 0 ? nullptr
+                          : ::mmap(nullptr, size, protection, MAP_SHARED,
+                                   descriptor, 0);
+        const int error = errno;
+        ::close(descriptor);
+        if (data_ == MAP_FAILED) {
+            errno = error;
+            detail::ThrowSystemError("Failed to map shared memory");
+        }
+    }
+
+    void* data_;
+    std::size_t size_;
+};
+#endif
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_SHARED_MEMORY_H
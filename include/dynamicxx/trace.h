@@ -0,0 +1,155 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Tracing hooks for dynamicxx hot paths.
+//
+// Hooks are compiled in only when DYNAMICXX_TRACE is defined to 1, or when a
+// DYNAMICXX_TRACE_HOOK(event, address, size) macro is defined before including
+// dynamicxx.h; otherwise they expand to nothing and their arguments are not
+// evaluated. A user-defined DYNAMICXX_TRACE_HOOK can forward straight to a
+// static probe, such as
+// `DTRACE_PROBE3(dynamicxx, event, static_cast<int>(event), address, size)`.
+// Without one, events go to the TraceSink installed with SetTraceSink().
+//
+// Events are raised from noexcept copy and destroy paths, so neither a hook
+// nor a sink may throw: an escaping exception calls std::terminate.
+
+#ifndef DYNAMICXX_TRACE_H
+#define DYNAMICXX_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// DeepCopy and Destroy events only fire for values whose subtree holds at
+// least this many string or blob bytes plus array and object elements.
+#ifndef DYNAMICXX_TRACE_LARGE_SIZE
+#define DYNAMICXX_TRACE_LARGE_SIZE 1024
+#endif
+
+namespace dynamicxx {
+
+enum struct TraceEvent : std::uint32_t {
+    // An accessor was used on a value holding a different type.
+    InvalidAccess = 0,
+    // An explicit Clone(); size is the element count of the root.
+    Clone,
+    // A large value was copied through a copy constructor or assignment; size
+    // counts the bytes and elements of the whole subtree. Values copied as
+    // part of a larger one are not reported separately.
+    DeepCopy,
+    // An array or object reallocated its storage; size is the new size.
+    Growth,
+    // A large value was destroyed; size is measured as for DeepCopy.
+    Destroy,
+};
+
+struct TraceRecord {
+    TraceEvent event;
+    const void* address;
+    std::size_t size;
+};
+
+class TraceSink {
+   public:
+    virtual ~TraceSink() = default;
+
+    // Called on the thread that triggered the event, possibly concurrently,
+    // and from inside noexcept functions: it must not throw.
+    virtual void Record(const TraceRecord& record) noexcept = 0;
+};
+
+namespace trace {
+
+inline std::atomic<TraceSink*>& SinkSlot() noexcept {
+    static std::atomic<TraceSink*> sink{nullptr};
+    return sink;
+}
+
+inline void Emit(const TraceEvent event, const void* address,
+                 const std::size_t size) noexcept {
+    auto* const sink = SinkSlot().load(std::memory_order_acquire);
+    if (sink != nullptr) {
+        sink->Record(TraceRecord{event, address, size});
+    }
+}
+
+}  // namespace trace
+
+// The sink must outlive every event it can receive; pass nullptr to stop
+// tracing. Returns the previous sink.
+inline TraceSink* SetTraceSink(TraceSink* sink) noexcept {
+    return trace::SinkSlot().exchange(sink, std::memory_order_acq_rel);
+}
+
+// A fixed-size sink that keeps the most recent records, overwriting the
+// oldest. Recording is a single atomic increment plus relaxed stores, so it
+// can stay installed in production.
+template <std::size_t Capacity = 4096>
+class TraceRingBuffer : public TraceSink {
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+   public:
+    void Record(const TraceRecord& record) noexcept override {
+        const auto index = next_.fetch_add(1, std::memory_order_relaxed);
+        auto& slot = slots_[index & (Capacity - 1)];
+        slot.event.store(static_cast<std::uint32_t>(record.event),
+                         std::memory_order_relaxed);
+        slot.address.store(record.address, std::memory_order_relaxed);
+        slot.size.store(record.size, std::memory_order_relaxed);
+    }
+
+    // Total number of records seen, including overwritten ones.
+    std::uint64_t Count() const noexcept {
+        return next_.load(std::memory_order_relaxed);
+    }
+
+    // The retained records, oldest first. Records written concurrently with
+    // the snapshot may be torn.
+    std::vector<TraceRecord> Snapshot() const {
+        const auto count = Count();
+        const auto retained =
+            count < Capacity ? count : static_cast<std::uint64_t>(Capacity);
+
+        std::vector<TraceRecord> records;
+        records.reserve(static_cast<std::size_t>(retained));
+        for (auto i = count - retained; i < count; ++i) {
+            const auto& slot = slots_[i & (Capacity - 1)];
+            records.push_back(TraceRecord{
+                static_cast<TraceEvent>(
+                    slot.event.load(std::memory_order_relaxed)),
+                slot.address.load(std::memory_order_relaxed),
+                slot.size.load(std::memory_order_relaxed)});
+        }
+        return records;
+    }
+
+   private:
+    struct Slot {
+        std::atomic<std::uint32_t> event{0};
+        std::atomic<const void*> address{nullptr};
+        std::atomic<std::size_t> size{0};
+    };
+
+    std::atomic<std::uint64_t> next_{0};
+    Slot slots_[Capacity];
+};
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_TRACE_H
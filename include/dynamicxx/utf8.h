@@ -0,0 +1,374 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// UTF-8 validation, and transcoding between UTF-8, UTF-16 and Latin-1.
+//
+// Validation follows the well-formed byte sequences of the Unicode standard
+// (table 3-7): overlong forms, surrogates and code points above U+10FFFF are
+// rejected. Text is mostly ASCII in practice, so every function skips ASCII 16
+// bytes at a time with SSE2 or NEON where available, and 8 at a time with
+// 64-bit words otherwise, and only decodes the multi-byte sequences one by one.
+
+#ifndef DYNAMICXX_UTF8_H
+#define DYNAMICXX_UTF8_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "dynamicxx/dynamicxx.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DYNAMICXX_HAS_SSE2 1
+#else
+#define DYNAMICXX_HAS_SSE2 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DYNAMICXX_HAS_NEON 1
+#else
+#define DYNAMICXX_HAS_NEON 0
+#endif
+
+namespace dynamicxx {
+
+// Text that is not valid in the encoding it was read as. Offset() is the
+// position, in code units, of the first ill-formed sequence.
+class InvalidEncodingException : public std::runtime_error {
+   public:
+    InvalidEncodingException(const char* what, const std::size_t offset)
+        : std::runtime_error(what), offset_(offset) {}
+
+    std::size_t Offset() const noexcept { return offset_; }
+
+   private:
+    std::size_t offset_;
+};
+
+namespace detail {
+namespace utf8 {
+
+// Length of the ASCII prefix of [data, data + size).
+inline std::size_t AsciiPrefix(const unsigned char* data,
+                               const std::size_t size) noexcept {
+    std::size_t i = 0;
+#if DYNAMICXX_HAS_SSE2
+    for (; i + 16 <= size; i += 16) {
+        const auto block =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(block) != 0) {
+            break;
+        }
+    }
+#elif DYNAMICXX_HAS_NEON
+    for (; i + 16 <= size; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(data + i)) >= 0x80) {
+            break;
+        }
+    }
+#endif
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if ((word & 0x8080808080808080U) != 0) {
+            break;
+        }
+    }
+    while (i < size && data[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+// Decodes the sequence starting at `data`, which is not ASCII. Returns its
+// length, or 0 if it is ill-formed or truncated.
+inline std::size_t DecodeSequence(const unsigned char* data,
+                                  const std::size_t size,
+                                  std::uint32_t& code_point) noexcept {
+    const unsigned lead = data[0];
+    std::size_t length;
+    unsigned low = 0x80;
+    unsigned high = 0xBF;
+    if (lead < 0xC2) {
+        return 0;
+    } else if (lead < 0xE0) {
+        length = 2;
+        code_point = lead & 0x1F;
+    } else if (lead < 0xF0) {
+        length = 3;
+        code_point = lead & 0x0F;
+        if (lead == 0xE0) {
+            low = 0xA0;  // Overlong.
+        } else if (lead == 0xED) {
+            high = 0x9F;  // Surrogates.
+        }
+    } else if (lead < 0xF5) {
+        length = 4;
+        code_point = lead & 0x07;
+        if (lead == 0xF0) {
+            low = 0x90;  // Overlong.
+        } else if (lead == 0xF4) {
+            high = 0x8F;  // Above U+10FFFF.
+        }
+    } else {
+        return 0;
+    }
+    if (size < length || data[1] < low || data[1] > high) {
+        return 0;
+    }
+    code_point = (code_point << 6) | (data[1] & 0x3F);
+    for (std::size_t i = 2; i < length; ++i) {
+        if ((data[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        code_point = (code_point << 6) | (data[i] & 0x3F);
+    }
+    return length;
+}
+
+inline const unsigned char* Bytes(const void* data) noexcept {
+    return static_cast<const unsigned char*>(data);
+}
+
+inline char* AppendUtf8(char* out, const std::uint32_t code_point) noexcept {
+    if (code_point < 0x80) {
+        *out++ = static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (code_point >> 6));
+        *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (code_point >> 12));
+        *out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (code_point >> 18));
+        *out++ = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+    return out;
+}
+
+}  // namespace utf8
+}  // namespace detail
+
+// Offset of the first ill-formed sequence in [data, data + size), or `size` if
+// it is all valid UTF-8.
+inline std::size_t FindInvalidUtf8(const void* data,
+                                   const std::size_t size) noexcept {
+    const auto* bytes = detail::utf8::Bytes(data);
+    std::size_t i = 0;
+    while (true) {
+        i += detail::utf8::AsciiPrefix(bytes + i, size - i);
+        if (i == size) {
+            return size;
+        }
+        std::uint32_t code_point;
+        const auto length =
+            detail::utf8::DecodeSequence(bytes + i, size - i, code_point);
+        if (length == 0) {
+            return i;
+        }
+        i += length;
+    }
+}
+
+inline bool IsValidUtf8(const void* data, const std::size_t size) noexcept {
+    return FindInvalidUtf8(data, size) == size;
+}
+inline bool IsValidUtf8(const std::string& text) noexcept {
+    return IsValidUtf8(text.data(), text.size());
+}
+
+// Throws InvalidEncodingException unless [data, data + size) is valid UTF-8.
+inline void ValidateUtf8(const void* data, const std::size_t size) {
+    const auto offset = FindInvalidUtf8(data, size);
+    if (offset != size) {
+        throw InvalidEncodingException("Invalid UTF-8", offset);
+    }
+}
+
+// Throws InvalidEncodingException if `data` is not valid UTF-8.
+inline std::u16string Utf8ToUtf16(const char* data, const std::size_t size) {
+    const auto* bytes = detail::utf8::Bytes(data);
+    // Never more UTF-16 code units than UTF-8 bytes.
+    std::u16string text(size, u'\0');
+    char16_t* out = &text[0];
+    std::size_t i = 0;
+    while (true) {
+        const auto ascii = detail::utf8::AsciiPrefix(bytes + i, size - i);
+        for (std::size_t end = i + ascii; i < end; ++i) {
+            *out++ = static_cast<char16_t>(bytes[i]);
+        }
+        if (i == size) {
+            break;
+        }
+        std::uint32_t code_point;
+        const auto length =
+            detail::utf8::DecodeSequence(bytes + i, size - i, code_point);
+        if (length == 0) {
+            throw InvalidEncodingException("Invalid UTF-8", i);
+        }
+        if (code_point < 0x10000) {
+            *out++ = static_cast<char16_t>(code_point);
+        } else {
+            code_point -= 0x10000;
+            *out++ = static_cast<char16_t>(0xD800 | (code_point >> 10));
+            *out++ = static_cast<char16_t>(0xDC00 | (code_point & 0x3FF));
+        }
+        i += length;
+    }
+    text.resize(static_cast<std::size_t>(out - text.data()));
+    return text;
+}
+inline std::u16string Utf8ToUtf16(const std::string& text) {
+    return Utf8ToUtf16(text.data(), text.size());
+}
+
+// Throws InvalidEncodingException on an unpaired surrogate.
+inline std::string Utf16ToUtf8(const char16_t* data, const std::size_t size) {
+    // At most three UTF-8 bytes per UTF-16 code unit.
+    std::string text(size * 3, '\0');
+    char* out = &text[0];
+    for (std::size_t i = 0; i < size; ++i) {
+        std::uint32_t code_point = data[i];
+        if (code_point < 0x80) {
+            *out++ = static_cast<char>(code_point);
+            continue;
+        }
+        if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+            if (code_point > 0xDBFF || i + 1 == size || data[i + 1] < 0xDC00 ||
+                data[i + 1] > 0xDFFF) {
+                throw InvalidEncodingException("Unpaired UTF-16 surrogate", i);
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                         (data[i + 1] - 0xDC00);
+            ++i;
+        }
+        out = detail::utf8::AppendUtf8(out, code_point);
+    }
+    text.resize(static_cast<std::size_t>(out - text.data()));
+    return text;
+}
+inline std::string Utf16ToUtf8(const std::u16string& text) {
+    return Utf16ToUtf8(text.data(), text.size());
+}
+
+// Latin-1 maps every byte to the code point of the same value, so this cannot
+// fail.
+inline std::string Latin1ToUtf8(const char* data, const std::size_t size) {
+    const auto* bytes = detail::utf8::Bytes(data);
+    std::string text;
+    text.reserve(size);
+    std::size_t i = 0;
+    while (true) {
+        const auto ascii = detail::utf8::AsciiPrefix(bytes + i, size - i);
+        text.append(data + i, ascii);
+        i += ascii;
+        if (i == size) {
+            break;
+        }
+        text.push_back(static_cast<char>(0xC0 | (bytes[i] >> 6)));
+        text.push_back(static_cast<char>(0x80 | (bytes[i] & 0x3F)));
+        ++i;
+    }
+    return text;
+}
+inline std::string Latin1ToUtf8(const std::string& text) {
+    return Latin1ToUtf8(text.data(), text.size());
+}
+
+// Throws InvalidEncodingException if `data` is not valid UTF-8, or holds a
+// code point above U+00FF.
+inline std::string Utf8ToLatin1(const char* data, const std::size_t size) {
+    const auto* bytes = detail::utf8::Bytes(data);
+    std::string text;
+    text.reserve(size);
+    std::size_t i = 0;
+    while (true) {
+        const auto ascii = detail::utf8::AsciiPrefix(bytes + i, size - i);
+        text.append(data + i, ascii);
+        i += ascii;
+        if (i == size) {
+            break;
+        }
+        std::uint32_t code_point;
+        const auto length =
+            detail::utf8::DecodeSequence(bytes + i, size - i, code_point);
+        if (length == 0) {
+            throw InvalidEncodingException("Invalid UTF-8", i);
+        }
+        if (code_point > 0xFF) {
+            throw InvalidEncodingException("Not representable in Latin-1", i);
+        }
+        text.push_back(static_cast<char>(code_point));
+        i += length;
+    }
+    return text;
+}
+inline std::string Utf8ToLatin1(const std::string& text) {
+    return Utf8ToLatin1(text.data(), text.size());
+}
+
+namespace detail {
+namespace utf8 {
+
+template <class Char>
+void ValidateText(const Char* data, const std::size_t size) {
+    if (sizeof(Char) == 1) {
+        ValidateUtf8(data, size);
+    }
+}
+
+}  // namespace utf8
+}  // namespace detail
+
+// Throws InvalidEncodingException unless every string, string view and object
+// key in `document` is valid UTF-8; its Offset() is into the first invalid one
+// found. Strings of wider characters are not checked.
+template <class DynamicType>
+void Validate(const DynamicType& document) {
+    static_assert(detail::IsBasicDynamicSpecialization<DynamicType>::value,
+                  "Validate expects a BasicDynamic");
+    using Char = typename DynamicType::String::value_type;
+    if (document.IsString()) {
+        detail::WithContiguous(document.GetString(),
+                               [](const Char* data, const std::size_t size) {
+                                   detail::utf8::ValidateText(data, size);
+                               });
+    } else if (document.IsStringView()) {
+        const auto view = document.GetStringView();
+        detail::utf8::ValidateText(view.data(), view.size());
+    } else if (document.IsArray()) {
+        for (const auto& value : document.GetArray()) {
+            Validate(value);
+        }
+    } else if (document.IsObject()) {
+        for (const auto& entry : document.GetObject()) {
+            detail::utf8::ValidateText(entry.first.data(), entry.first.size());
+            Validate(entry.second);
+        }
+    }
+}
+
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_UTF8_H
@@ -0,0 +1,188 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// The dynamicxx named module. It wraps the headers rather than replacing them,
+// so `import dynamicxx;` and `#include <dynamicxx/dynamicxx.h>` name the same
+// entities and can be mixed within a program.
+//
+// Macros cannot cross a module boundary: the instrumentation and tracing modes
+// are fixed by how this interface unit is compiled, and so is whether the
+// allocation statistics and trace sinks are exported.
+
+module;
+
+#include "dynamicxx/bignum.h"
+#include "dynamicxx/binary.h"
+#include "dynamicxx/cache.h"
+#include "dynamicxx/dictionary.h"
+#include "dynamicxx/document_store.h"
+#include "dynamicxx/dynamicxx.h"
+#include "dynamicxx/literal.h"
+#include "dynamicxx/numeric.h"
+#include "dynamicxx/ordered_map.h"
+#include "dynamicxx/profile.h"
+#include "dynamicxx/queue.h"
+#include "dynamicxx/rope.h"
+#include "dynamicxx/shared_blob.h"
+#include "dynamicxx/shared_memory.h"
+#include "dynamicxx/utf8.h"
+
+export module dynamicxx;
+
+export using ::DynamicxxMap;
+
+export namespace dynamicxx {
+
+// dynamicxx.h
+using dynamicxx::BasicDynamic;
+using dynamicxx::DefaultArrayContainer;
+using dynamicxx::DefaultBlobContainer;
+using dynamicxx::DefaultInteger;
+using dynamicxx::DefaultNumber;
+using dynamicxx::DefaultObjectContainer;
+using dynamicxx::DefaultString;
+using dynamicxx::DefaultToIndex;
+using dynamicxx::DefaultToString;
+using dynamicxx::DuplicateKeys;
+using dynamicxx::Dynamic;
+using dynamicxx::DynamicManaged;
+using dynamicxx::IntStringifier;
+using dynamicxx::InvalidAccessException;
+using dynamicxx::IsIntegerPolicy;
+using dynamicxx::IsNumberPolicy;
+using dynamicxx::MemoryFootprint;
+using dynamicxx::ParseError;
+using dynamicxx::ParseInteger;
+using dynamicxx::ParseResult;
+
+// bignum.h
+using dynamicxx::BigInteger;
+using dynamicxx::Decimal;
+using dynamicxx::DynamicExact;
+
+// binary.h
+using dynamicxx::DecodeBinary;
+using dynamicxx::EncodeBinary;
+using dynamicxx::InvalidBinaryException;
+using dynamicxx::StringEncoding;
+
+// cache.h
+using dynamicxx::CacheOptions;
+using dynamicxx::CacheStats;
+using dynamicxx::DynamicCache;
+
+// dictionary.h
+using dynamicxx::StringDictionary;
+
+#if DYNAMICXX_INSTRUMENT
+// instrument.h
+using dynamicxx::AllocationCounters;
+using dynamicxx::AllocationKind;
+using dynamicxx::AllocationStats;
+using dynamicxx::CountingAllocator;
+using dynamicxx::InstrumentedArrayContainer;
+using dynamicxx::InstrumentedBlobContainer;
+using dynamicxx::InstrumentedObjectContainer;
+using dynamicxx::InstrumentedString;
+using dynamicxx::ResetStats;
+using dynamicxx::stats;
+#endif
+
+// document_store.h
+using dynamicxx::DocumentPath;
+#if DYNAMICXX_HAS_MMAP
+using dynamicxx::DocumentStore;
+#endif
+using dynamicxx::DocumentStoreOptions;
+using dynamicxx::DocumentStoreStats;
+using dynamicxx::PathStep;
+
+// literal.h
+using dynamicxx::Literal;
+using dynamicxx::LiteralKind;
+using dynamicxx::LiteralMember;
+
+// numeric.h
+using dynamicxx::ParseNumber;
+
+// ordered_map.h
+using dynamicxx::OrderedDynamic;
+using dynamicxx::OrderedMap;
+
+// profile.h
+using dynamicxx::AddToProfile;
+using dynamicxx::Histogram;
+using dynamicxx::Profile;
+using dynamicxx::ProfileOptions;
+using dynamicxx::ProfileSampler;
+using dynamicxx::ShapeProfile;
+
+// queue.h
+using dynamicxx::IsTriviallyRelocatable;
+using dynamicxx::MpscQueue;
+using dynamicxx::SpscQueue;
+
+// rope.h
+using dynamicxx::BasicRope;
+using dynamicxx::DynamicRope;
+using dynamicxx::Rope;
+
+// shared_blob.h
+using dynamicxx::CollectIoSlices;
+using dynamicxx::DynamicSharedBlob;
+using dynamicxx::IoSlice;
+using dynamicxx::SharedBlob;
+using dynamicxx::SharedBlobContainer;
+
+// shared_memory.h
+using dynamicxx::Freeze;
+using dynamicxx::OffsetPtr;
+using dynamicxx::ReadSegment;
+using dynamicxx::SegmentArena;
+#if DYNAMICXX_HAS_MMAP
+using dynamicxx::SharedMemory;
+#endif
+using dynamicxx::SharedValue;
+
+#if DTRACING
+// trace.h
+using dynamicxx::SetTraceSink;
+using dynamicxx::TraceEvent;
+using dynamicxx::TraceRecord;
+using dynamicxx::TraceRingBuffer;
+using dynamicxx::TraceSink;
+#endif
+
+// utf8.h
+using dynamicxx::FindInvalidUtf8;
+using dynamicxx::InvalidEncodingException;
+using dynamicxx::IsValidUtf8;
+using dynamicxx::Latin1ToUtf8;
+using dynamicxx::Utf16ToUtf8;
+using dynamicxx::Utf8ToLatin1;
+using dynamicxx::Utf8ToUtf16;
+using dynamicxx::Validate;
+using dynamicxx::ValidateUtf8;
+
+namespace detail {
+// Needed to spell out BasicDynamic specializations and to catch conversion
+// errors.
+using dynamicxx::detail::ConverstionError;
+using dynamicxx::detail::IsBasicDynamicSpecialization;
+using dynamicxx::detail::Just;
+}  // namespace detail
+
+}  // namespace dynamicxx
@@ -0,0 +1,33 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// The single place Dynamic and DynamicManaged are instantiated when linking
+// against dynamicxx_core; see DYNAMICXX_EXTERN_TEMPLATES in dynamicxx.h.
+
+#include "dynamicxx/dynamicxx.h"
+
+namespace dynamicxx {
+
+template class BasicDynamic<DefaultInteger, DefaultNumber, DefaultString,
+                            DefaultBlobContainer, DefaultArrayContainer,
+                            DefaultObjectContainer, DefaultToString,
+                            DefaultToIndex, detail::Just>;
+template class BasicDynamic<DefaultInteger, DefaultNumber, DefaultString,
+                            DefaultBlobContainer, DefaultArrayContainer,
+                            DefaultObjectContainer, DefaultToString,
+                            DefaultToIndex, std::shared_ptr>;
+
+}  // namespace dynamicxx
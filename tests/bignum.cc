@@ -0,0 +1,131 @@
+#include <dynamicxx/bignum.h>
+#include <dynamicxx/dynamicxx.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using dynamicxx::BigInteger;
+using dynamicxx::Decimal;
+using dynamicxx::DynamicExact;
+
+TEST(BigIntegerTest, SmallValuesStayInline) {
+    const BigInteger a = 40;
+    const BigInteger b = 2;
+    EXPECT_TRUE((a + b).FitsInt64());
+    EXPECT_EQ((a + b).ToInt64(), 42);
+    EXPECT_EQ((a - b * 30).ToString(), "-20");
+    EXPECT_EQ(BigInteger(std::numeric_limits<std::int64_t>::min()).ToString(),
+              "-9223372036854775808");
+}
+
+TEST(BigIntegerTest, SpillsPast64Bits) {
+    const BigInteger max = std::numeric_limits<std::int64_t>::max();
+    const auto over = max + 1;
+    EXPECT_FALSE(over.FitsInt64());
+    EXPECT_EQ(over.ToString(), "9223372036854775808");
+    EXPECT_THROW((void)over.ToInt64(), std::overflow_error);
+    EXPECT_EQ(BigInteger(std::numeric_limits<std::uint64_t>::max()).ToString(),
+              "18446744073709551615");
+
+    // Coming back into range returns to the inline representation.
+    EXPECT_TRUE((over - 1).FitsInt64());
+    EXPECT_EQ(over - 1, max);
+    EXPECT_EQ(-over, std::numeric_limits<std::int64_t>::min());
+    EXPECT_TRUE((-over).FitsInt64());
+
+    const auto id = BigInteger::Parse("123456789012345678901234567890");
+    EXPECT_EQ(id.ToString(), "123456789012345678901234567890");
+    EXPECT_EQ((id * id).ToString(),
+              "15241578753238836750495351562536198787501905199875019052100");
+    EXPECT_EQ((id * -id + id * id).ToString(), "0");
+    EXPECT_EQ((-id).ToString(), "-123456789012345678901234567890");
+    EXPECT_EQ((id - (id + 1)).ToInt64(), -1);
+    EXPECT_NEAR(id.ToDouble(), 1.2345678901234568e29, 1e14);
+}
+
+TEST(BigIntegerTest, Compares) {
+    const auto large = BigInteger::Parse("-100000000000000000000");
+    EXPECT_LT(large, BigInteger(-1));
+    EXPECT_LT(large, large + 1);
+    EXPECT_GT(-large, large);
+    EXPECT_EQ(large, BigInteger::Parse("-100000000000000000000"));
+    EXPECT_NE(large, -large);
+    EXPECT_THROW((void)BigInteger::Parse("12a"), std::invalid_argument);
+    EXPECT_THROW((void)BigInteger::Parse("-"), std::invalid_argument);
+}
+
+TEST(DecimalTest, ParsesAndPrintsExactly) {
+    EXPECT_EQ(Decimal::Parse("12.50").ToString(), "12.50");
+    EXPECT_EQ(Decimal::Parse("-0.007").ToString(), "-0.007");
+    EXPECT_EQ(Decimal::Parse("1.5e3").ToString(), "1500");
+    EXPECT_EQ(Decimal::Parse("25e-4").ToString(), "0.0025");
+    EXPECT_EQ(Decimal::Parse("12345678901234567890.12").ToString(),
+              "12345678901234567890.12");
+    EXPECT_THROW((void)Decimal::Parse("1.2.3"), std::invalid_argument);
+    EXPECT_THROW((void)Decimal::Parse("."), std::invalid_argument);
+    EXPECT_THROW((void)Decimal::Parse("1e99999"), std::out_of_range);
+}
+
+TEST(DecimalTest, Arithmetic) {
+    const auto price = Decimal::Parse("19.99");
+    const auto total = price * 3 + Decimal::Parse("0.03");
+    EXPECT_EQ(total.ToString(), "60.00");
+    EXPECT_EQ(total, Decimal(60));
+    EXPECT_EQ(Decimal::Parse("1.50"), Decimal::Parse("1.5"));
+    EXPECT_LT(Decimal::Parse("0.1") + Decimal::Parse("0.2"),
+              Decimal::Parse("0.30000000000000001"));
+    EXPECT_EQ(Decimal::Parse("0.1") + Decimal::Parse("0.2"),
+              Decimal::Parse("0.3"));
+    EXPECT_EQ((Decimal::Parse("1") - Decimal::Parse("0.001")).ToString(),
+              "0.999");
+}
+
+TEST(DecimalTest, FromDouble) {
+    EXPECT_EQ(Decimal(0.1).ToString(), "0.1");
+    EXPECT_EQ(Decimal(-2.5).ToString(), "-2.5");
+    EXPECT_EQ(Decimal(1e21).ToString(), "1000000000000000000000");
+    EXPECT_EQ(Decimal(0.0).ToString(), "0");
+    EXPECT_EQ(Decimal(0.1).ToDouble(), 0.1);
+    EXPECT_THROW(Decimal(std::numeric_limits<double>::infinity()),
+                 std::invalid_argument);
+}
+
+TEST(DecimalTest, InDynamic) {
+    DynamicExact order = DynamicExact::From<DynamicExact::Object>();
+    order["id"] = BigInteger::Parse("98765432109876543210");
+    order["amount"] = Decimal::Parse("1024.10");
+    order["count"] = 3;
+    order["ratio"] = 0.25;
+
+    ASSERT_TRUE(order["id"].IsInteger());
+    EXPECT_EQ(order["id"].GetInteger().ToString(), "98765432109876543210");
+    ASSERT_TRUE(order["amount"].IsNumber());
+    EXPECT_EQ(order["amount"].GetNumber().ToString(), "1024.10");
+    EXPECT_EQ(order["count"].GetInteger(), 3);
+    EXPECT_EQ(order["ratio"].GetNumber(), Decimal::Parse("0.25"));
+
+    const DynamicExact copy = order.Clone();
+    EXPECT_EQ(copy, order);
+}
+
+TEST(DecimalTest, MemoryUsageCountsSpilledLimbs) {
+    DynamicExact small = DynamicExact::From<DynamicExact::Array>();
+    small.GetArray().push_back(DynamicExact::From<BigInteger>(1));
+    small.GetArray().push_back(
+        DynamicExact::From<Decimal>(Decimal::Parse("1.5")));
+    EXPECT_EQ(small.MemoryUsage().number_bytes, 0U);
+
+    const auto id = BigInteger::Parse("123456789012345678901234567890");
+    const auto amount = Decimal::Parse("-98765432109876543210.123");
+    DynamicExact large = DynamicExact::From<DynamicExact::Array>();
+    large.GetArray().push_back(DynamicExact::From<BigInteger>(id));
+    large.GetArray().push_back(DynamicExact::From<Decimal>(amount));
+    const auto usage = large.MemoryUsage();
+    EXPECT_GT(id.HeapBytes(), 0U);
+    EXPECT_EQ(usage.number_bytes, id.HeapBytes() + amount.HeapBytes());
+    EXPECT_EQ(usage.Total() - small.MemoryUsage().Total(),
+              usage.number_bytes);
+}
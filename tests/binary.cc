@@ -0,0 +1,95 @@
+#include <dynamicxx/binary.h>
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/ordered_map.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using dynamicxx::DecodeBinary;
+using dynamicxx::Dynamic;
+using dynamicxx::EncodeBinary;
+using dynamicxx::InvalidBinaryException;
+using dynamicxx::OrderedDynamic;
+
+TEST(BinaryTest, RoundTrips) {
+    Dynamic d = Dynamic::From<Dynamic::Object>();
+    d["null"] = Dynamic::From<Dynamic::Null>();
+    d["yes"] = true;
+    d["no"] = false;
+    d["small"] = -3;
+    d["min"] = std::numeric_limits<std::int64_t>::min();
+    d["max"] = std::numeric_limits<std::int64_t>::max();
+    d["ratio"] = 0.1;
+    d["name"] = "dynamicxx";
+    d["bytes"] = Dynamic::Blob{0, 1, 255};
+    d["list"] = Dynamic::From<Dynamic::Array>();
+    d["list"].GetArray().push_back(Dynamic::Of(1));
+    d["list"].GetArray().push_back(Dynamic::From<Dynamic::Object>());
+    d["undefined"] = Dynamic::From<Dynamic::Undefined>();
+
+    const auto bytes = EncodeBinary(d);
+    EXPECT_EQ(DecodeBinary<Dynamic>(bytes), d);
+
+    // Views are encoded as what they refer to.
+    const std::string text = "borrowed";
+    Dynamic view = Dynamic::From<Dynamic::StringView>(
+        Dynamic::StringView(text.data(), text.size()));
+    EXPECT_EQ(DecodeBinary<Dynamic>(EncodeBinary(view)).GetString(), text);
+}
+
+TEST(BinaryTest, IsCompact) {
+    EXPECT_EQ(EncodeBinary(Dynamic::Of(5)), std::string("\x03\x0A", 2));
+    EXPECT_EQ(EncodeBinary(Dynamic::Of(-1)), std::string("\x03\x01", 2));
+    EXPECT_EQ(EncodeBinary(Dynamic::Of(300)), std::string("\x03\xD8\x04", 3));
+    EXPECT_EQ(EncodeBinary(Dynamic::Of("hi")), std::string("\x05\x02hi", 4));
+}
+
+TEST(BinaryTest, KeepsObjectOrder) {
+    OrderedDynamic d = OrderedDynamic::From<OrderedDynamic::Object>();
+    d["zebra"] = 1;
+    d["apple"] = 2;
+    const auto decoded = DecodeBinary<OrderedDynamic>(EncodeBinary(d));
+    EXPECT_EQ(decoded.GetObject().begin()->first, "zebra");
+}
+
+TEST(BinaryTest, RejectsInvalidInput) {
+    const auto bytes = EncodeBinary(Dynamic::Of("truncated"));
+    try {
+        (void)DecodeBinary<Dynamic>(bytes.data(), bytes.size() - 1);
+        FAIL() << "Expected InvalidBinaryException";
+    } catch (const InvalidBinaryException& e) {
+        EXPECT_EQ(e.Offset(), 2U);
+    }
+    EXPECT_THROW((void)DecodeBinary<Dynamic>(bytes + "x"),
+                 InvalidBinaryException);
+    EXPECT_THROW((void)DecodeBinary<Dynamic>(std::string("\x42", 1)),
+                 InvalidBinaryException);
+    // A huge count is rejected before anything is reserved.
+    EXPECT_THROW(
+        (void)DecodeBinary<Dynamic>(std::string("\x07\xFF\xFF\xFF\xFF\x0F", 6)),
+        InvalidBinaryException);
+    EXPECT_THROW((void)DecodeBinary<Dynamic>(std::string(10000, '\x07')),
+                 InvalidBinaryException);
+}
+
+TEST(BinaryTest, RefusesToEncodeWhatCannotBeDecoded) {
+    auto d = Dynamic::Of(1);
+    for (int i = 0; i < 512; ++i) {
+        auto array = Dynamic::From<Dynamic::Array>();
+        array.GetArray().push_back(std::move(d));
+        d = std::move(array);
+    }
+    // 512 levels deep is the most DecodeBinary() accepts.
+    EXPECT_EQ(DecodeBinary<Dynamic>(EncodeBinary(d)), d);
+
+    auto deeper = Dynamic::From<Dynamic::Array>();
+    deeper.GetArray().push_back(std::move(d));
+    std::string out = "prefix";
+    EXPECT_THROW(EncodeBinary(deeper, out), dynamicxx::BinaryDepthException);
+    EXPECT_EQ(out, "prefix");
+    EXPECT_THROW(
+        (void)EncodeBinary(deeper, dynamicxx::StringEncoding::Dictionary),
+        dynamicxx::BinaryDepthException);
+}
@@ -0,0 +1,174 @@
+#include <dynamicxx/cache.h>
+#include <dynamicxx/dynamicxx.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using dynamicxx::CacheOptions;
+using dynamicxx::Dynamic;
+using dynamicxx::DynamicCache;
+
+namespace {
+
+Dynamic MakeDocument(const std::size_t payload) {
+    Dynamic d = Dynamic::From<Dynamic::Object>();
+    d["payload"] = std::string(payload, 'x');
+    return d;
+}
+
+CacheOptions SingleShard(const std::size_t byte_budget) {
+    CacheOptions options;
+    options.byte_budget = byte_budget;
+    options.shards = 1;
+    return options;
+}
+
+}  // namespace
+
+TEST(DynamicCacheTest, HitsShareTheDocument) {
+    DynamicCache<std::string> cache;
+    EXPECT_EQ(cache.Get("config"), nullptr);
+    const auto put = cache.Put("config", MakeDocument(16));
+    const auto first = cache.Get("config");
+    const auto second = cache.Get("config");
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first.get(), put.get());
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ((*first)["payload"].GetString(), std::string(16, 'x'));
+
+    const auto stats = cache.Stats();
+    EXPECT_EQ(stats.hits, 2U);
+    EXPECT_EQ(stats.misses, 1U);
+    EXPECT_EQ(stats.insertions, 1U);
+    EXPECT_EQ(stats.entries, 1U);
+    EXPECT_GE(stats.bytes, MakeDocument(16).MemoryUsage().Total());
+}
+
+TEST(DynamicCacheTest, EvictsByBytesInLruOrder) {
+    const auto size = [] {
+        DynamicCache<int> probe(SingleShard(1 << 20));
+        (void)probe.Put(0, MakeDocument(1000));
+        return probe.Stats().bytes;
+    }();
+    DynamicCache<int> cache(SingleShard(size * 3));
+    for (int i = 0; i < 3; ++i) {
+        (void)cache.Put(i, MakeDocument(1000));
+    }
+    EXPECT_EQ(cache.Stats().evictions, 0U);
+
+    // Use 1 before 0 and 2, so that it is the least recently used.
+    const auto held = cache.Get(1);
+    (void)cache.Get(0);
+    (void)cache.Get(2);
+    (void)cache.Put(3, MakeDocument(1000));
+    EXPECT_EQ(cache.Get(1), nullptr);
+    EXPECT_NE(cache.Get(0), nullptr);
+    EXPECT_EQ(cache.Stats().evictions, 1U);
+    // An evicted document lives on while it is held.
+    EXPECT_EQ((*held)["payload"].GetString().size(), 1000U);
+
+    // One large document displaces several small ones.
+    (void)cache.Put(4, MakeDocument(2500));
+    EXPECT_EQ(cache.Stats().entries, 1U);
+    EXPECT_LE(cache.Stats().bytes, cache.ByteBudget());
+
+    // One larger than the budget is handed back but not cached.
+    const auto huge = cache.Put(5, MakeDocument(size * 4));
+    EXPECT_NE(huge, nullptr);
+    EXPECT_EQ(cache.Get(5), nullptr);
+    EXPECT_EQ(cache.Stats().rejections, 1U);
+}
+
+TEST(DynamicCacheTest, ReplacesEraseAndClear) {
+    DynamicCache<std::string> cache;
+    (void)cache.Put("a", Dynamic::Of(1));
+    (void)cache.Put("a", Dynamic::Of(2));
+    EXPECT_EQ(cache.Get("a")->GetInteger(), 2);
+    EXPECT_EQ(cache.Stats().entries, 1U);
+
+    int made = 0;
+    const auto make = [&made] {
+        ++made;
+        return Dynamic::Of(3);
+    };
+    EXPECT_EQ(cache.GetOrPut("b", make)->GetInteger(), 3);
+    EXPECT_EQ(cache.GetOrPut("b", make)->GetInteger(), 3);
+    EXPECT_EQ(made, 1);
+
+    EXPECT_TRUE(cache.Erase("a"));
+    EXPECT_FALSE(cache.Erase("a"));
+    cache.Clear();
+    EXPECT_EQ(cache.Stats().entries, 0U);
+    EXPECT_EQ(cache.Stats().bytes, 0U);
+    EXPECT_THROW((void)cache.Put("c", DynamicCache<std::string>::Handle()),
+                 std::invalid_argument);
+
+    CacheOptions options;
+    options.shards = 5;
+    EXPECT_EQ(DynamicCache<int>(options).ShardCount(), 8U);
+}
+
+TEST(DynamicCacheTest, ReleasesDocumentsOutsideTheLock) {
+    using Cache = DynamicCache<int>;
+    Cache cache(SingleShard(std::size_t{1} << 20));
+    int released = 0;
+    // A document whose destruction uses the same shard, which would deadlock
+    // if it were released under the shard's lock.
+    const auto tracked = [&cache, &released](const std::size_t payload) {
+        return Cache::Handle(new Dynamic(MakeDocument(payload)),
+                             [&cache, &released](const Dynamic* document) {
+                                 (void)cache.Get(-1);
+                                 ++released;
+                                 delete document;
+                             });
+    };
+
+    (void)cache.Put(1, tracked(8));
+    (void)cache.Put(1, tracked(8));
+    EXPECT_EQ(released, 1);
+    EXPECT_TRUE(cache.Erase(1));
+    EXPECT_EQ(released, 2);
+    (void)cache.Put(2, tracked(8));
+    cache.Clear();
+    EXPECT_EQ(released, 3);
+    (void)cache.Put(3, tracked(8));
+    (void)cache.Put(4, tracked(std::size_t{3} << 18));
+    (void)cache.Put(5, tracked(std::size_t{3} << 18));
+    EXPECT_EQ(released, 5);
+    cache.Clear();
+}
+
+TEST(DynamicCacheTest, IsThreadSafe) {
+    CacheOptions options;
+    options.byte_budget = 256 * 1024;
+    DynamicCache<int> cache(options);
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, &wrong, t] {
+            for (int i = 0; i < 5000; ++i) {
+                const int key = (i * 31 + t) % 200;
+                const auto value = cache.GetOrPut(key, [key] {
+                    Dynamic d = Dynamic::From<Dynamic::Object>();
+                    d["key"] = key;
+                    return d;
+                });
+                if ((*value)["key"].GetInteger() != key) {
+                    ++wrong;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(wrong.load(), 0);
+    const auto stats = cache.Stats();
+    EXPECT_EQ(stats.hits + stats.misses, 4U * 5000U);
+    EXPECT_LE(stats.bytes, cache.ByteBudget());
+}
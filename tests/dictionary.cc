@@ -0,0 +1,130 @@
+#include <dynamicxx/binary.h>
+#include <dynamicxx/dictionary.h>
+#include <dynamicxx/dynamicxx.h>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dynamicxx::DecodeBinary;
+using dynamicxx::Dynamic;
+using dynamicxx::EncodeBinary;
+using dynamicxx::StringDictionary;
+using dynamicxx::StringEncoding;
+
+namespace {
+
+const char* const Levels[] = {"info", "warn", "error"};
+
+Dynamic MakeLogs(const int count) {
+    Dynamic logs = Dynamic::From<Dynamic::Array>();
+    for (int i = 0; i < count; ++i) {
+        Dynamic record = Dynamic::From<Dynamic::Object>();
+        record["level"] = Levels[i % 3];
+        record["region"] = i % 2 == 0 ? "eu-west" : "us-east";
+        record["message"] = "request " + std::to_string(i);
+        logs.GetArray().push_back(std::move(record));
+    }
+    return logs;
+}
+
+}  // namespace
+
+TEST(StringDictionaryTest, InternsOnce) {
+    StringDictionary dictionary;
+    const auto info = dictionary.Intern("info");
+    EXPECT_EQ(dictionary.Intern(std::string("warn")), 1U);
+    EXPECT_EQ(dictionary.Intern("info"), info);
+    EXPECT_EQ(dictionary.size(), 2U);
+    EXPECT_EQ(dictionary.At(info), StringDictionary::View("info"));
+    EXPECT_EQ(dictionary.At(info).data(), dictionary.At(info).data());
+
+    StringDictionary::Code code;
+    EXPECT_TRUE(dictionary.Find("warn", code));
+    EXPECT_EQ(code, 1U);
+    EXPECT_FALSE(dictionary.Find("error", code));
+    EXPECT_THROW((void)dictionary.At(7), std::out_of_range);
+
+    // Codes come from addresses, so only the dictionary's own copies have one.
+    EXPECT_EQ(dictionary.CodeOf(dictionary.At(1)), 1U);
+    const std::string copy = "warn";
+    EXPECT_THROW((void)dictionary.CodeOf(copy), std::invalid_argument);
+}
+
+TEST(StringDictionaryTest, EncodesDocuments) {
+    auto logs = MakeLogs(30);
+    const auto original = logs.Clone();
+    StringDictionary dictionary(9);
+    // "request 10" and later are longer than 9 bytes, so stay as they are.
+    EXPECT_EQ(dictionary.Encode(logs), 30U * 2 + 10);
+    EXPECT_EQ(dictionary.size(), 3U + 2 + 10);
+    EXPECT_EQ(logs, original);
+    EXPECT_TRUE(logs[0]["level"].IsStringView());
+    EXPECT_TRUE(logs[20]["message"].IsString());
+
+    // Group by level using codes.
+    std::map<StringDictionary::Code, int> counts;
+    for (const auto& record : logs.GetArray()) {
+        ++counts[dictionary.CodeOf(record["level"].GetStringView())];
+    }
+    ASSERT_EQ(counts.size(), 3U);
+    StringDictionary::Code error;
+    ASSERT_TRUE(dictionary.Find("error", error));
+    EXPECT_EQ(counts[error], 10);
+
+    logs.Materialize();
+    EXPECT_TRUE(logs[0]["level"].IsString());
+    EXPECT_EQ(logs, original);
+}
+
+TEST(StringDictionaryTest, EncodesBinary) {
+    const auto logs = MakeLogs(300);
+    const auto inline_bytes = EncodeBinary(logs);
+    const auto dictionary_bytes =
+        EncodeBinary(logs, StringEncoding::Dictionary);
+    // The level and region of each record shrink to a byte each.
+    EXPECT_LT(dictionary_bytes.size() + 300 * 10, inline_bytes.size());
+    EXPECT_EQ(DecodeBinary<Dynamic>(dictionary_bytes), logs);
+
+    // A document with no repeated strings has an empty table.
+    const auto single = Dynamic::Of("once");
+    EXPECT_EQ(EncodeBinary(single, StringEncoding::Dictionary),
+              std::string("\x0A\x00\x05\x04once", 8));
+
+    // Decoding into a dictionary gives views of its strings, shared across
+    // documents.
+    StringDictionary dictionary;
+    const auto first = DecodeBinary<Dynamic>(dictionary_bytes, dictionary);
+    const auto second = DecodeBinary<Dynamic>(inline_bytes, dictionary);
+    EXPECT_EQ(first, logs);
+    EXPECT_EQ(first[5]["region"].GetStringView().data(),
+              second[7]["region"].GetStringView().data());
+
+    EXPECT_THROW(
+        (void)DecodeBinary<Dynamic>(std::string("\x0A\x00\x0B\x00", 4)),
+        dynamicxx::InvalidBinaryException);
+}
+
+TEST(StringDictionaryTest, BoundsHowFarReferencesExpand) {
+    // Long strings are written inline even when repeated.
+    Dynamic long_strings = Dynamic::From<Dynamic::Array>();
+    for (int i = 0; i < 2; ++i) {
+        long_strings.Push(std::string(65, 'x').c_str());
+    }
+    const auto encoded =
+        EncodeBinary(long_strings, StringEncoding::Dictionary);
+    EXPECT_EQ(encoded.compare(0, 2, std::string("\x0A\x00", 2)), 0);
+    EXPECT_EQ(DecodeBinary<Dynamic>(encoded), long_strings);
+
+    // A table entry of 4000 bytes referenced 1000 times would decode to 4 MB.
+    std::string bomb("\x0A\x01\xA0\x1F", 4);
+    bomb += std::string(4000, 'x');
+    bomb += std::string("\x07\xE8\x07", 3);
+    for (int i = 0; i < 1000; ++i) {
+        bomb += std::string("\x0B\x00", 2);
+    }
+    EXPECT_THROW((void)DecodeBinary<Dynamic>(bomb),
+                 dynamicxx::InvalidBinaryException);
+}
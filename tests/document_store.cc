@@ -0,0 +1,216 @@
+#include <dynamicxx/document_store.h>
+#include <dynamicxx/dynamicxx.h>
+#include <gtest/gtest.h>
+
+#if DYNAMICXX_HAS_MMAP
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using dynamicxx::Dynamic;
+using dynamicxx::DocumentStore;
+using dynamicxx::DocumentStoreOptions;
+
+namespace {
+
+class DocumentStoreTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/dynamicxx_store_XXXXXX";
+        ASSERT_NE(::mkdtemp(pattern), nullptr);
+        directory_ = pattern;
+    }
+    void TearDown() override {
+        for (const char* name :
+             {"snapshot", "log", "snapshot.tmp", "log.tmp"}) {
+            std::remove((directory_ + "/" + name).c_str());
+        }
+        ::rmdir(directory_.c_str());
+    }
+
+    std::string directory_;
+};
+
+}  // namespace
+
+TEST_F(DocumentStoreTest, RecoversChanges) {
+    {
+        auto store = DocumentStore<>::Open(directory_);
+        store.Set({"name"}, Dynamic::Of("sidecar"));
+        store.Set({"routes"}, Dynamic::From<Dynamic::Array>());
+        store.Push({"routes"}, Dynamic::Of("/a"));
+        store.Push({"routes"}, Dynamic::Of("/b"));
+        store.Set({"routes", 0}, Dynamic::Of("/z"));
+        store.Set({"temporary"}, Dynamic::Of(1));
+        store.Erase({"temporary"});
+        // A change that fails is neither applied nor logged.
+        EXPECT_THROW(store.Set({"missing", "key"}, Dynamic::Of(1)),
+                     std::out_of_range);
+        EXPECT_THROW(store.Set({"routes", 5}, Dynamic::Of(1)),
+                     std::out_of_range);
+        EXPECT_EQ(store.Stats().records, 7U);
+    }
+    const auto store = DocumentStore<>::Open(directory_);
+    const auto root = store.Get();
+    EXPECT_EQ(root["name"].GetString(), "sidecar");
+    ASSERT_EQ(root["routes"].size(), 2U);
+    EXPECT_EQ(root["routes"][0].GetString(), "/z");
+    EXPECT_EQ(root["routes"][1].GetString(), "/b");
+    EXPECT_FALSE(root.Contains("temporary"));
+}
+
+TEST_F(DocumentStoreTest, DiscardsATornRecord) {
+    std::size_t intact;
+    {
+        auto store = DocumentStore<>::Open(directory_);
+        store.Set({"a"}, Dynamic::Of(1));
+        intact = store.Stats().log_bytes;
+        store.Set({"b"}, Dynamic::Of(2));
+    }
+    // Cut the last record short, as a crash during its write would.
+    const auto log = directory_ + "/log";
+    ASSERT_EQ(::truncate(log.c_str(), static_cast<off_t>(intact + 3)), 0);
+    {
+        auto store = DocumentStore<>::Open(directory_);
+        EXPECT_EQ(store.Get()["a"].GetInteger(), 1);
+        EXPECT_FALSE(store.Get().Contains("b"));
+        EXPECT_EQ(store.Stats().log_bytes, intact);
+        store.Set({"c"}, Dynamic::Of(3));
+    }
+    const auto store = DocumentStore<>::Open(directory_);
+    EXPECT_EQ(store.Get()["c"].GetInteger(), 3);
+}
+
+TEST_F(DocumentStoreTest, SnapshotsCompactTheLog) {
+    DocumentStoreOptions options;
+    options.snapshot_log_bytes = 1024;
+    {
+        auto store = DocumentStore<>::Open(directory_, options);
+        store.Set({"counters"}, Dynamic::From<Dynamic::Object>());
+        for (int i = 0; i < 200; ++i) {
+            store.Set({"counters", "n" + std::to_string(i % 10)},
+                      Dynamic::Of(i));
+        }
+        EXPECT_GT(store.Stats().snapshots, 0U);
+        EXPECT_LE(store.Stats().log_bytes, 1024U + 64U);
+    }
+    {
+        auto store = DocumentStore<>::Open(directory_, options);
+        EXPECT_EQ(store.Get()["counters"]["n9"].GetInteger(), 199);
+        store.Snapshot();
+        EXPECT_THROW(store.Push({"list"}, Dynamic::Of(1)), std::out_of_range);
+        store.Set({"counters", "n0"}, Dynamic::Of(-1));
+    }
+    auto store = DocumentStore<>::Open(directory_, options);
+    EXPECT_EQ(store.Get()["counters"].size(), 10U);
+    EXPECT_EQ(store.Get()["counters"]["n0"].GetInteger(), -1);
+    EXPECT_FALSE(store.Get().Contains("list"));
+}
+
+TEST_F(DocumentStoreTest, RefusesChangesAfterAFailedSnapshot) {
+    // A directory in the way of the new log lets the snapshot be renamed
+    // into place and then fails StartLog(), whatever the permissions.
+    const auto blocker = directory_ + "/log.tmp";
+    {
+        auto store = DocumentStore<>::Open(directory_);
+        store.Set({"kept"}, Dynamic::Of(1));
+        ASSERT_EQ(::mkdir(blocker.c_str(), 0700), 0);
+        EXPECT_THROW(store.Snapshot(), std::system_error);
+        // Appending to the old log would be acknowledged and then dropped.
+        EXPECT_THROW(store.Set({"lost"}, Dynamic::Of(2)), std::runtime_error);
+    }
+    ASSERT_EQ(::rmdir(blocker.c_str()), 0);
+    {
+        auto store = DocumentStore<>::Open(directory_);
+        EXPECT_EQ(store.Get()["kept"].GetInteger(), 1);
+        EXPECT_FALSE(store.Get().Contains("lost"));
+    }
+
+    // An automatic snapshot does not fail the change that triggered it,
+    // which is already durable.
+    DocumentStoreOptions options;
+    options.snapshot_log_bytes = 1;
+    {
+        auto store = DocumentStore<>::Open(directory_, options);
+        ASSERT_EQ(::mkdir(blocker.c_str(), 0700), 0);
+        EXPECT_NO_THROW(store.Set({"durable"}, Dynamic::Of(3)));
+        EXPECT_THROW(store.Set({"lost"}, Dynamic::Of(4)), std::runtime_error);
+    }
+    ASSERT_EQ(::rmdir(blocker.c_str()), 0);
+    const auto store = DocumentStore<>::Open(directory_);
+    EXPECT_EQ(store.Get()["durable"].GetInteger(), 3);
+    EXPECT_FALSE(store.Get().Contains("lost"));
+}
+
+TEST_F(DocumentStoreTest, RejectsChangesTooDeepToReopen) {
+    auto deep = Dynamic::Of(1);
+    for (int i = 0; i < 300; ++i) {
+        auto array = Dynamic::From<Dynamic::Array>();
+        array.GetArray().push_back(std::move(deep));
+        deep = std::move(array);
+    }
+    {
+        auto store = DocumentStore<>::Open(directory_);
+        dynamicxx::DocumentPath path;
+        for (int i = 0; i < 300; ++i) {
+            store.Set(path, Dynamic::From<Dynamic::Object>());
+            path.emplace_back("a");
+        }
+        // Fits on its own, but not 300 levels down.
+        EXPECT_THROW(store.Set(path, deep.Clone()),
+                     dynamicxx::BinaryDepthException);
+        path.pop_back();
+        store.Set(path, Dynamic::From<Dynamic::Array>());
+        EXPECT_THROW(store.Push(path, deep.Clone()),
+                     dynamicxx::BinaryDepthException);
+        EXPECT_EQ(store.Stats().records, 301U);
+        store.Snapshot();
+    }
+    const auto store = DocumentStore<>::Open(directory_);
+    EXPECT_EQ(store.Stats().records, 0U);
+}
+
+TEST_F(DocumentStoreTest, GroupsConcurrentCommits) {
+    constexpr int Threads = 8;
+    constexpr int PerThread = 50;
+    {
+        auto store = DocumentStore<>::Open(directory_);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < Threads; ++t) {
+            store.Set({"t" + std::to_string(t)},
+                      Dynamic::From<Dynamic::Array>());
+        }
+        for (int t = 0; t < Threads; ++t) {
+            threads.emplace_back([&store, t] {
+                for (int i = 0; i < PerThread; ++i) {
+                    store.Push({"t" + std::to_string(t)}, Dynamic::Of(i));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const auto stats = store.Stats();
+        EXPECT_EQ(stats.records, Threads * (PerThread + 1U));
+        EXPECT_LE(stats.commits, stats.records);
+    }
+    const auto store = DocumentStore<>::Open(directory_);
+    store.Read([](const Dynamic& root) {
+        for (int t = 0; t < Threads; ++t) {
+            const auto& list = root["t" + std::to_string(t)];
+            ASSERT_EQ(list.size(), static_cast<std::size_t>(PerThread));
+            for (int i = 0; i < PerThread; ++i) {
+                EXPECT_EQ(list[i].GetInteger(), i);
+            }
+        }
+    });
+}
+#endif
@@ -0,0 +1,55 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/literal.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "EmbeddedConfig.h"
+
+using dynamicxx::Dynamic;
+using dynamicxx::Literal;
+
+TEST(EmbedTest, Scalars) {
+    const Literal& config = dynamicxx_tests::EmbeddedConfig();
+
+    ASSERT_TRUE(config.IsObject());
+    EXPECT_TRUE(config.IsSorted());
+    EXPECT_EQ(std::string(config["service"].GetString()), "edge");
+    EXPECT_EQ(config["port"].GetInteger(), 8443);
+    EXPECT_EQ(config["ratio"].GetNumber(), 0.25);
+    EXPECT_TRUE(config["enabled"].GetBoolean());
+    EXPECT_TRUE(config["fallback"].IsNull());
+    // Integers beyond 64 bits become numbers.
+    EXPECT_EQ(config["big"].GetNumber(), 18446744073709551616.0);
+}
+
+TEST(EmbedTest, Strings) {
+    const Literal& escapes = dynamicxx_tests::EmbeddedConfig()["escapes"];
+    EXPECT_EQ(std::string(escapes.GetString(), escapes.size()),
+              "tab\tquote\"\xc3\xa9?");
+}
+
+TEST(EmbedTest, Containers) {
+    const Literal& config = dynamicxx_tests::EmbeddedConfig();
+
+    EXPECT_EQ(config["empty_array"].size(), 0U);
+    EXPECT_EQ(config["empty_object"].size(), 0U);
+    EXPECT_FALSE(config["empty_object"].Contains("anything"));
+
+    const Literal& routes = config["routes"];
+    ASSERT_EQ(routes.size(), 2U);
+    EXPECT_EQ(std::string(routes[1]["path"].GetString()), "/api");
+    EXPECT_EQ(routes[1]["weight"].GetInteger(),
+              std::numeric_limits<std::int64_t>::min());
+    EXPECT_EQ(config.At(std::string("routes")).size(), 2U);
+}
+
+TEST(EmbedTest, ToDynamic) {
+    const Dynamic config =
+        dynamicxx_tests::EmbeddedConfig().ToDynamic<Dynamic>();
+    EXPECT_EQ(config.size(), 10U);
+    EXPECT_EQ(config["routes"][0]["weight"].GetInteger(), 10);
+    EXPECT_EQ(config["service"].GetString(), "edge");
+}
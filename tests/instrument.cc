@@ -0,0 +1,89 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/instrument.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+using dynamicxx::AllocationKind;
+
+using InstrumentedDynamic =
+    dynamicxx::BasicDynamic<dynamicxx::DefaultInteger, dynamicxx::DefaultNumber,
+                            dynamicxx::InstrumentedString,
+                            dynamicxx::InstrumentedBlobContainer,
+                            dynamicxx::InstrumentedArrayContainer,
+                            dynamicxx::InstrumentedObjectContainer>;
+
+TEST(InstrumentTest, CountsPerContainerKind) {
+    dynamicxx::ResetStats();
+    {
+        auto d = InstrumentedDynamic::From<InstrumentedDynamic::Array>();
+        d.Push(std::string(256, 'x').c_str());
+        d.Push(42);
+
+        const auto stats = dynamicxx::stats();
+        EXPECT_GE(stats.Of(AllocationKind::Array).allocations, 1U);
+        EXPECT_GE(stats.Of(AllocationKind::String).bytes_allocated, 256U);
+        EXPECT_EQ(stats.Of(AllocationKind::Object).allocations, 0U);
+        EXPECT_GT(stats.Of(AllocationKind::String).LiveBytes(), 0U);
+    }
+
+    // Everything is returned once the document is gone.
+    const auto stats = dynamicxx::stats();
+    EXPECT_EQ(stats.Total().LiveAllocations(), 0U);
+    EXPECT_EQ(stats.Total().LiveBytes(), 0U);
+    EXPECT_EQ(stats.Of(AllocationKind::String).deallocations,
+              stats.Of(AllocationKind::String).allocations);
+}
+
+TEST(InstrumentTest, AggregatesAcrossThreads) {
+    dynamicxx::ResetStats();
+
+    std::thread worker([] {
+        auto d = InstrumentedDynamic::From<InstrumentedDynamic::Blob>();
+        d.GetBlob().resize(1024);
+    });
+    worker.join();
+
+    // The worker has exited, so its counters must have been retired rather
+    // than lost.
+    const auto stats = dynamicxx::stats();
+    const auto& blob = stats.Of(AllocationKind::Blob);
+    EXPECT_EQ(blob.allocations, 1U);
+    EXPECT_EQ(blob.deallocations, 1U);
+    EXPECT_EQ(blob.bytes_allocated, 1024U);
+}
+
+TEST(InstrumentTest, CountsFreesOnThreadsThatNeverAllocated) {
+    dynamicxx::ResetStats();
+
+    auto d = InstrumentedDynamic::From<InstrumentedDynamic::Blob>();
+    d.GetBlob().resize(64);
+
+    // The worker's first use of a counting allocator is a deallocation.
+    std::thread worker([moved = std::move(d)]() mutable {
+        moved = InstrumentedDynamic();
+    });
+    worker.join();
+
+    const auto stats = dynamicxx::stats();
+    const auto& blob = stats.Of(AllocationKind::Blob);
+    EXPECT_EQ(blob.allocations, 1U);
+    EXPECT_EQ(blob.deallocations, 1U);
+}
+
+#if DYNAMICXX_INSTRUMENT
+TEST(InstrumentTest, DefaultContainersAreCounted) {
+    dynamicxx::ResetStats();
+    {
+        auto d = dynamicxx::Dynamic::From<dynamicxx::Dynamic::Array>();
+        d.Push(1);
+        d.Push(std::string("not counted, String stays std::string").c_str());
+
+        const auto stats = dynamicxx::stats();
+        EXPECT_GE(stats.Of(AllocationKind::Array).allocations, 1U);
+        EXPECT_EQ(stats.Of(AllocationKind::String).allocations, 0U);
+    }
+    EXPECT_EQ(dynamicxx::stats().Total().LiveBytes(), 0U);
+}
+#endif
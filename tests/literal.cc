@@ -0,0 +1,88 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/literal.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+using dynamicxx::Dynamic;
+using dynamicxx::Literal;
+using dynamicxx::LiteralMember;
+
+namespace {
+
+DCONSTEXPR_14 Literal kPorts[] = {80, 443};
+DCONSTEXPR_14 LiteralMember kLimits[] = {
+    {"burst", 64},
+    {"rate", 12.5},
+};
+DCONSTEXPR_14 LiteralMember kServer[] = {
+    {"enabled", true},
+    {"limits", kLimits},
+    {"name", "edge"},
+    {"ports", kPorts},
+    {"proxy", nullptr},
+};
+DCONSTEXPR_14 Literal kConfig = kServer;
+
+DCONSTEXPR_14 LiteralMember kUnsorted[] = {
+    {"b", 2},
+    {"a", 1},
+    {"b", 3},
+};
+
+#if DHAS_CXX_14
+static_assert(kConfig.IsObject(), "");
+static_assert(kConfig.IsSorted(), "");
+static_assert(kConfig.size() == 5, "");
+static_assert(kConfig["ports"][1].GetInteger() == 443, "");
+static_assert(kConfig["limits"]["rate"].GetNumber() == 12.5, "");
+static_assert(kConfig["enabled"].GetBoolean(), "");
+static_assert(kConfig["name"].size() == 4, "");
+static_assert(kConfig["proxy"].IsNull(), "");
+static_assert(!kConfig.Contains("missing"), "");
+#endif
+
+}  // namespace
+
+TEST(LiteralTest, Queries) {
+    EXPECT_TRUE(kConfig.IsSorted());
+    EXPECT_EQ(kConfig["ports"].size(), 2U);
+    EXPECT_EQ(kConfig["ports"][0].GetInteger(), 80);
+    EXPECT_EQ(std::string(kConfig["name"].GetString()), "edge");
+    EXPECT_EQ(kConfig.Find("missing"), nullptr);
+    EXPECT_EQ(kConfig["limits"].Find("burst")->GetInteger(), 64);
+
+    EXPECT_THROW((void)kConfig["missing"], dynamicxx::InvalidAccessException);
+    EXPECT_THROW((void)kConfig["ports"][2], dynamicxx::InvalidAccessException);
+    EXPECT_THROW((void)kConfig["name"].GetInteger(),
+                 dynamicxx::InvalidAccessException);
+}
+
+TEST(LiteralTest, UnsortedObjectsScanInOrder) {
+    const Literal object = kUnsorted;
+    EXPECT_FALSE(object.IsSorted());
+    EXPECT_EQ(object["a"].GetInteger(), 1);
+    // The first of duplicate keys wins.
+    EXPECT_EQ(object["b"].GetInteger(), 2);
+}
+
+TEST(LiteralTest, StringOf) {
+    static const char kText[] = "key=value";
+    const Literal value = Literal::StringOf(kText + 4, 5);
+    EXPECT_TRUE(value.IsString());
+    EXPECT_EQ(std::string(value.GetString(), value.size()), "value");
+}
+
+TEST(LiteralTest, ToDynamic) {
+    const Dynamic config = kConfig.ToDynamic<Dynamic>();
+
+    ASSERT_TRUE(config.IsObject());
+    EXPECT_EQ(config.size(), 5U);
+    EXPECT_TRUE(config["enabled"].GetBoolean());
+    EXPECT_EQ(config["name"].GetString(), "edge");
+    EXPECT_TRUE(config["proxy"].IsNull());
+    ASSERT_TRUE(config["ports"].IsArray());
+    EXPECT_EQ(config["ports"][1].GetInteger(), 443);
+    EXPECT_EQ(config["limits"]["burst"].GetInteger(), 64);
+    EXPECT_EQ(config["limits"]["rate"].GetNumber(), 12.5);
+}
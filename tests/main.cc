@@ -3,7 +3,12 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 using dynamicxx::Dynamic;
 using dynamicxx::DynamicManaged;
@@ -102,3 +107,153 @@ TEST(DynamicTest, ManagedDeepClone) {
 
     ASSERT_EQ(d[FooBarKey], clone[FooBarKey]);
 }
+
+TEST(DynamicTest, MemoryUsage) {
+    const std::string long_string(1000, 'x');
+
+    Dynamic d = Dynamic::From<Dynamic::Object>();
+    d["small"] = 1;
+    d["large"] = long_string.c_str();
+    d["array"] = Dynamic::Array{};
+    d["array"].GetArray().reserve(8);
+    d["array"].Push(1.5);
+
+    const auto usage = d.MemoryUsage();
+    EXPECT_GE(usage.string_bytes, long_string.size());
+    EXPECT_EQ(usage.inline_bytes, 5 * sizeof(Dynamic));
+    EXPECT_GE(usage.container_overhead, 7 * sizeof(Dynamic));
+    EXPECT_GT(usage.key_bytes, 0U);
+    EXPECT_EQ(usage.managed_bytes, 0U);
+    EXPECT_EQ(usage.shared_bytes, 0U);
+    EXPECT_EQ(usage.exclusive_bytes, usage.Total());
+}
+
+TEST(DynamicTest, ManagedMemoryUsageSharing) {
+    DynamicManaged d = DynamicManaged::From<DynamicManaged::Array>();
+    d.Push(std::string(1000, 'x').c_str());
+    d.Push(42);
+
+    const auto exclusive = d.MemoryUsage();
+    EXPECT_GT(exclusive.managed_bytes, 0U);
+    EXPECT_EQ(exclusive.shared_bytes, 0U);
+    EXPECT_EQ(exclusive.exclusive_bytes, exclusive.Total());
+
+    // A second handle to the first element shares its string.
+    const DynamicManaged alias = d[0];
+    const auto shared = d.MemoryUsage();
+    EXPECT_EQ(shared.Total(), exclusive.Total());
+    EXPECT_GE(shared.shared_bytes, 1000U);
+    EXPECT_EQ(shared.exclusive_bytes + shared.shared_bytes, shared.Total());
+}
+
+TEST(DynamicTest, StringAndBlobViews) {
+    const std::string buffer = "{\"name\":\"edge\"}";
+    const std::vector<std::uint8_t> bytes = {1, 2, 3};
+
+    Dynamic d = Dynamic::From<Dynamic::Object>();
+    d["name"] = Dynamic::StringView(buffer.data() + 9, 4);
+    d["bytes"] = Dynamic::BlobView(bytes);
+
+    ASSERT_TRUE(d["name"].IsStringView());
+    EXPECT_FALSE(d["name"].IsString());
+    EXPECT_EQ(d["name"].GetStringView().data(), buffer.data() + 9);
+    EXPECT_EQ(d["name"].ToStringView(), Dynamic::StringView("edge"));
+    EXPECT_EQ(d["bytes"].GetBlobView().size(), 3U);
+    EXPECT_THROW((void)d["name"].GetString(),
+                 dynamicxx::InvalidAccessException);
+
+    // Borrowed and owned values compare by content.
+    EXPECT_EQ(d["name"], Dynamic::From<Dynamic::String>("edge"));
+
+    const auto usage = d.MemoryUsage();
+    EXPECT_EQ(usage.borrowed_bytes, 7U);
+    EXPECT_EQ(usage.string_bytes, 0U);
+    EXPECT_EQ(usage.blob_bytes, 0U);
+
+    const Dynamic before = d.Clone();
+    EXPECT_TRUE(d.HasViews());
+    d.Materialize();
+    EXPECT_FALSE(d.HasViews());
+    ASSERT_TRUE(d["name"].IsString());
+    EXPECT_NE(d["name"].GetString().data(), buffer.data() + 9);
+    EXPECT_EQ(d["name"].GetString(), "edge");
+    ASSERT_TRUE(d["bytes"].IsBlob());
+    EXPECT_EQ(d["bytes"].GetBlob(), bytes);
+    EXPECT_EQ(d, before);
+    EXPECT_EQ(d.MemoryUsage().borrowed_bytes, 0U);
+}
+
+TEST(DynamicTest, IntegerKeys) {
+    Dynamic d = Dynamic::From<Dynamic::Object>();
+    d[0] = "zero";
+    d[-42] = "negative";
+    d[1234567890123LL] = "id";
+    d[std::numeric_limits<std::int64_t>::min()] = "min";
+    d[std::numeric_limits<std::uint64_t>::max()] = "max";
+    d[std::string("named")] = "string";
+
+    EXPECT_EQ(d["0"].GetString(), "zero");
+    EXPECT_EQ(d["-42"].GetString(), "negative");
+    EXPECT_EQ(d["1234567890123"].GetString(), "id");
+    EXPECT_EQ(d["-9223372036854775808"].GetString(), "min");
+    EXPECT_EQ(d["18446744073709551615"].GetString(), "max");
+    EXPECT_EQ(d["named"].GetString(), "string");
+
+    const dynamicxx::IntStringifier<std::string> stringify;
+    std::uint64_t power = 1;
+    for (int digits = 1; digits < 20; ++digits, power *= 10) {
+        EXPECT_EQ(stringify.Convert(power), std::to_string(power));
+        EXPECT_EQ(stringify.Convert(power - 1), std::to_string(power - 1));
+        const auto negative = -static_cast<std::int64_t>(power);
+        EXPECT_EQ(stringify.Convert(negative), std::to_string(negative));
+    }
+    EXPECT_EQ(stringify.Convert(static_cast<std::uint8_t>(255)), "255");
+    EXPECT_EQ(stringify.Convert(static_cast<short>(-7)), "-7");
+}
+
+TEST(DynamicTest, ObjectBuilder) {
+    Dynamic::ObjectBuilder builder;
+    builder.Reserve(4).Add("name", "widget").Add(std::string("count"), 3);
+    builder.Add(7, Dynamic::From<Dynamic::Array>()).Add("count", 4);
+    EXPECT_EQ(builder.size(), 4U);
+
+    const auto object = builder.Finish();
+    EXPECT_EQ(builder.size(), 0U);
+    ASSERT_TRUE(object.IsObject());
+    EXPECT_EQ(object.size(), 3U);
+    EXPECT_EQ(object["name"].GetString(), "widget");
+    EXPECT_EQ(object["count"].GetInteger(), 4);
+    EXPECT_TRUE(object["7"].IsArray());
+
+    Dynamic expected = Dynamic::From<Dynamic::Object>();
+    expected["name"] = "widget";
+    expected["count"] = 4;
+    expected["7"] = Dynamic::From<Dynamic::Array>();
+    EXPECT_EQ(object, expected);
+}
+
+TEST(DynamicTest, FromPairs) {
+    std::vector<std::pair<std::string, int>> pairs;
+    for (int i = 0; i < 300; ++i) {
+        pairs.emplace_back("key" + std::to_string((i * 7) % 200), i);
+    }
+
+    const auto last = Dynamic::FromPairs(pairs);
+    const auto first =
+        Dynamic::FromPairs(pairs.begin(), pairs.end(),
+                           dynamicxx::DuplicateKeys::KeepFirst);
+    ASSERT_EQ(last.size(), 200U);
+    ASSERT_EQ(first.size(), 200U);
+    for (int i = 0; i < 300; ++i) {
+        const auto& key = pairs[i].first;
+        EXPECT_EQ(last[key.c_str()].GetInteger(), i < 100 ? i + 200 : i);
+        EXPECT_EQ(first[key.c_str()].GetInteger(), i < 200 ? i : i - 200);
+    }
+
+    EXPECT_THROW(
+        (void)Dynamic::FromPairs(pairs, dynamicxx::DuplicateKeys::Throw),
+        std::invalid_argument);
+    pairs.resize(200);
+    EXPECT_EQ(Dynamic::FromPairs(pairs, dynamicxx::DuplicateKeys::Throw),
+              first);
+}
@@ -0,0 +1,217 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/numeric.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+using dynamicxx::Dynamic;
+using dynamicxx::ParseError;
+using dynamicxx::ParseInteger;
+using dynamicxx::ParseNumber;
+
+namespace {
+
+template <class Type>
+ParseError Parse(const std::string& text, Type& value,
+                 std::size_t* consumed = nullptr) {
+    const auto result =
+        ParseInteger(text.data(), text.data() + text.size(), value);
+    if (consumed != nullptr) {
+        *consumed = static_cast<std::size_t>(result.end - text.data());
+    }
+    return result.error;
+}
+
+double Number(const std::string& text) {
+    double value = 0;
+    const auto result =
+        ParseNumber(text.data(), text.data() + text.size(), value);
+    EXPECT_EQ(result.error, ParseError::None) << text;
+    EXPECT_EQ(result.end, text.data() + text.size()) << text;
+    return value;
+}
+
+void ExpectMatchesStrtod(const std::string& text) {
+    const double expected = std::strtod(text.c_str(), nullptr);
+    if (!std::isfinite(expected)) {
+        return;  // Rounded up past the largest double; tested separately.
+    }
+    const double actual = Number(text);
+    EXPECT_EQ(std::memcmp(&expected, &actual, sizeof(double)), 0)
+        << text << ": " << expected << " != " << actual;
+}
+
+}  // namespace
+
+TEST(ParseIntegerTest, Unsigned) {
+    std::uint64_t value = 0;
+    std::size_t consumed = 0;
+    EXPECT_EQ(Parse("12345678", value), ParseError::None);
+    EXPECT_EQ(value, 12345678U);
+    EXPECT_EQ(Parse("1234567890123456789x", value, &consumed),
+              ParseError::None);
+    EXPECT_EQ(value, 1234567890123456789U);
+    EXPECT_EQ(consumed, 19U);
+    EXPECT_EQ(Parse("000000000000000000000042", value), ParseError::None);
+    EXPECT_EQ(value, 42U);
+    EXPECT_EQ(Parse("18446744073709551615", value), ParseError::None);
+    EXPECT_EQ(value, std::numeric_limits<std::uint64_t>::max());
+
+    value = 7;
+    EXPECT_EQ(Parse("18446744073709551616", value, &consumed),
+              ParseError::Overflow);
+    EXPECT_EQ(consumed, 20U);
+    EXPECT_EQ(Parse("20000000000000000000", value), ParseError::Overflow);
+    EXPECT_EQ(Parse("99999999999999999999", value), ParseError::Overflow);
+    EXPECT_EQ(Parse("123456789012345678901", value), ParseError::Overflow);
+    EXPECT_EQ(value, 7U);
+    EXPECT_EQ(Parse("", value), ParseError::Empty);
+    EXPECT_EQ(Parse("x1", value), ParseError::Empty);
+}
+
+TEST(ParseIntegerTest, Signed) {
+    std::int64_t value = 0;
+    EXPECT_EQ(Parse("-9223372036854775808", value), ParseError::None);
+    EXPECT_EQ(value, std::numeric_limits<std::int64_t>::min());
+    EXPECT_EQ(Parse("9223372036854775807", value), ParseError::None);
+    EXPECT_EQ(value, std::numeric_limits<std::int64_t>::max());
+    EXPECT_EQ(Parse("9223372036854775808", value), ParseError::Overflow);
+    EXPECT_EQ(Parse("-9223372036854775809", value), ParseError::Overflow);
+    EXPECT_EQ(Parse("-", value), ParseError::Empty);
+}
+
+TEST(ParseIntegerTest, MatchesScalarParsing) {
+    std::mt19937_64 random(7);
+    for (int i = 0; i < 100000; ++i) {
+        const auto expected = random() >> (random() % 64);
+        const auto text = std::to_string(expected);
+        std::uint64_t value = 0;
+        ASSERT_EQ(Parse(text, value), ParseError::None) << text;
+        ASSERT_EQ(value, expected) << text;
+    }
+}
+
+TEST(ParseIntegerTest, IndexConversion) {
+    const dynamicxx::DefaultToIndex to_index;
+    std::size_t index = 0;
+    EXPECT_EQ(to_index.TryConvert("17", 2, index), ParseError::None);
+    EXPECT_EQ(index, 17U);
+    EXPECT_EQ(to_index.TryConvert("1 ", 2, index), ParseError::InvalidCharacter);
+    EXPECT_EQ(to_index.TryConvert("", 0, index), ParseError::Empty);
+    EXPECT_EQ(to_index.TryConvert("99999999999999999999", 20, index),
+              ParseError::Overflow);
+    EXPECT_EQ(index, 17U);
+
+    Dynamic d = Dynamic::From<Dynamic::Array>();
+    for (int i = 0; i < 20; ++i) {
+        d.Push(i * i);
+    }
+    EXPECT_EQ(d["17"].GetInteger(), 289);
+    EXPECT_THROW((void)d["-1"], dynamicxx::detail::ConverstionError);
+    EXPECT_THROW((void)d["99999999999999999999"],
+                 dynamicxx::detail::ConverstionError);
+}
+
+TEST(ParseNumberTest, Grammar) {
+    EXPECT_EQ(Number("0"), 0.0);
+    EXPECT_EQ(Number("-2.5"), -2.5);
+    EXPECT_EQ(Number(".5"), 0.5);
+    EXPECT_EQ(Number("1e3"), 1000.0);
+    EXPECT_EQ(Number("1E+3"), 1000.0);
+    EXPECT_EQ(Number("125e-3"), 0.125);
+    EXPECT_TRUE(std::signbit(Number("-0")));
+
+    double value = 1;
+    const std::string trailing = "12.5e";
+    auto result = ParseNumber(trailing.data(),
+                              trailing.data() + trailing.size(), value);
+    EXPECT_EQ(result.error, ParseError::None);
+    EXPECT_EQ(result.end, trailing.data() + 4);
+    EXPECT_EQ(value, 12.5);
+
+    const std::string empty = "-.e5";
+    result = ParseNumber(empty.data(), empty.data() + empty.size(), value);
+    EXPECT_EQ(result.error, ParseError::Empty);
+    EXPECT_EQ(result.end, empty.data());
+
+    const std::string huge = "1e400";
+    result = ParseNumber(huge.data(), huge.data() + huge.size(), value);
+    EXPECT_EQ(result.error, ParseError::Overflow);
+    EXPECT_EQ(value, 12.5);
+    const std::string huge_digits = "1" + std::string(400, '0');
+    result = ParseNumber(huge_digits.data(),
+                         huge_digits.data() + huge_digits.size(), value);
+    EXPECT_EQ(result.error, ParseError::Overflow);
+
+    // Too many digits for the fast paths, and too small for a double.
+    const std::string tiny = "1.00000000000000000000e-400";
+    result = ParseNumber(tiny.data(), tiny.data() + tiny.size(), value);
+    EXPECT_EQ(result.error, ParseError::None);
+    EXPECT_EQ(value, 0.0);
+    const std::string negative_tiny = "-" + tiny;
+    result = ParseNumber(negative_tiny.data(),
+                         negative_tiny.data() + negative_tiny.size(), value);
+    EXPECT_EQ(result.error, ParseError::None);
+    EXPECT_TRUE(std::signbit(value));
+}
+
+TEST(ParseNumberTest, HardCases) {
+    const char* const cases[] = {
+        "2.2250738585072011e-308",  // Largest subnormal.
+        "2.2250738585072014e-308",  // Smallest normal.
+        "4.9406564584124654e-324",  // Smallest subnormal.
+        "2.4703282292062327e-324",  // Halfway to zero.
+        "2.4703282292062328e-324",
+        "1.7976931348623157e308",
+        "1.7976931348623158e308",
+        "9007199254740993",         // 2^53 + 1: ties to even.
+        "9007199254740995",
+        "0.1",
+        "0.3",
+        "123456789012345678901234567890",
+        "0.000000000000000000000000000001234567890123456789",
+        "7.038531e-26",
+        "1e-400",
+        "1.00000000000000000000e-400",
+        "4.94065645841246544176568792868221372365059802614e-324",
+        "2.0000000000000004",
+        "4.503599627370497e15",
+    };
+    for (const char* text : cases) {
+        ExpectMatchesStrtod(text);
+    }
+}
+
+TEST(ParseNumberTest, MatchesStrtod) {
+    std::mt19937_64 random(42);
+    char text[64];
+    for (int i = 0; i < 200000; ++i) {
+        std::uint64_t bits = random();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+        std::snprintf(text, sizeof(text), "%.*g",
+                      static_cast<int>(random() % 17) + 1, value);
+        ExpectMatchesStrtod(text);
+        if (HasFailure()) {
+            return;
+        }
+    }
+    for (int i = 0; i < 200000; ++i) {
+        const auto digits = std::to_string(random() >> (random() % 64));
+        const int exponent = static_cast<int>(random() % 700) - 350;
+        ExpectMatchesStrtod(digits + "e" + std::to_string(exponent));
+        if (HasFailure()) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/ordered_map.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dynamicxx::OrderedDynamic;
+using dynamicxx::OrderedMap;
+
+namespace {
+
+template <class Map>
+std::vector<std::string> KeysOf(const Map& map) {
+    std::vector<std::string> keys;
+    for (const auto& entry : map) {
+        keys.push_back(entry.first);
+    }
+    return keys;
+}
+
+}  // namespace
+
+TEST(OrderedMapTest, KeepsInsertionOrder) {
+    OrderedMap<std::string, int> map;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 1000; ++i) {
+        // Neither sorted nor in hash order.
+        const auto key = "key" + std::to_string((i * 7919) % 1000);
+        map[key] = i;
+        expected.push_back(key);
+    }
+    ASSERT_EQ(map.size(), 1000U);
+    EXPECT_EQ(KeysOf(map), expected);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(map.at(expected[i]), i);
+    }
+
+    // Existing keys keep their position.
+    EXPECT_FALSE(map.try_emplace(expected[3], -1).second);
+    map[expected[3]] = -3;
+    EXPECT_EQ(map.begin()[3].second, -3);
+    EXPECT_TRUE(map.find("missing") == map.end());
+    EXPECT_THROW((void)map.at("missing"), std::out_of_range);
+}
+
+TEST(OrderedMapTest, EraseKeepsOrder) {
+    OrderedMap<std::string, int> map;
+    for (int i = 0; i < 20; ++i) {
+        map[std::to_string(i)] = i;
+    }
+    EXPECT_EQ(map.erase("5"), 1U);
+    EXPECT_EQ(map.erase("5"), 0U);
+    const auto next = map.erase(map.begin());
+    EXPECT_EQ(next->first, "1");
+
+    std::vector<std::string> expected;
+    for (int i = 1; i < 20; ++i) {
+        if (i != 5) {
+            expected.push_back(std::to_string(i));
+        }
+    }
+    EXPECT_EQ(KeysOf(map), expected);
+    for (const auto& key : expected) {
+        EXPECT_EQ(map.at(key), std::stoi(key));
+    }
+    map["5"] = 5;
+    EXPECT_EQ((map.end() - 1)->first, "5");
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.count("1"), 0U);
+    map["again"] = 1;
+    EXPECT_EQ(map.size(), 1U);
+}
+
+TEST(OrderedMapTest, ComparesRegardlessOfOrder) {
+    OrderedMap<std::string, int> a;
+    OrderedMap<std::string, int> b;
+    a["x"] = 1;
+    a["y"] = 2;
+    b["y"] = 2;
+    b["x"] = 1;
+    EXPECT_EQ(a, b);
+    b["x"] = 3;
+    EXPECT_NE(a, b);
+}
+
+TEST(OrderedMapTest, InDynamic) {
+    OrderedDynamic d = OrderedDynamic::From<OrderedDynamic::Object>();
+    d["zeta"] = 1;
+    d["alpha"] = "two";
+    d["mid"] = OrderedDynamic::From<OrderedDynamic::Object>();
+    d["mid"]["second"] = 2;
+    d["mid"]["first"] = 1;
+
+    EXPECT_EQ(KeysOf(d.GetObject()),
+              (std::vector<std::string>{"zeta", "alpha", "mid"}));
+    EXPECT_TRUE(d.Contains("alpha"));
+
+    const OrderedDynamic copy = d.Clone();
+    EXPECT_EQ(copy, d);
+    EXPECT_EQ(KeysOf(copy["mid"].GetObject()),
+              (std::vector<std::string>{"second", "first"}));
+
+    const auto usage = d.MemoryUsage();
+    EXPECT_GT(usage.container_overhead, 0U);
+}
+
+TEST(OrderedMapTest, BuilderKeepsFirstPosition) {
+    OrderedDynamic::ObjectBuilder builder;
+    builder.Add("b", 1).Add("a", 2).Add("b", 3);
+    const auto object = builder.Finish();
+    EXPECT_EQ(KeysOf(object.GetObject()),
+              (std::vector<std::string>{"b", "a"}));
+    EXPECT_EQ(object["b"].GetInteger(), 3);
+}
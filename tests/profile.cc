@@ -0,0 +1,108 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/profile.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+using dynamicxx::Dynamic;
+using dynamicxx::Histogram;
+
+namespace {
+
+Dynamic MakeRecord(const int id) {
+    Dynamic record = Dynamic::From<Dynamic::Object>();
+    record["id"] = id;
+    record["level"] = "info";
+    record["tags"] = Dynamic::Array{};
+    record["tags"].Push(true);
+    record["tags"].Push(1.5);
+    return record;
+}
+
+}  // namespace
+
+TEST(ProfileTest, HistogramBuckets) {
+    EXPECT_EQ(Histogram::BucketOf(0), 0U);
+    EXPECT_EQ(Histogram::BucketOf(1), 1U);
+    EXPECT_EQ(Histogram::BucketOf(3), 2U);
+    EXPECT_EQ(Histogram::BucketOf(4), 3U);
+    EXPECT_EQ(Histogram::LowerBound(3), 4U);
+
+    Histogram histogram;
+    for (int i = 0; i < 100; ++i) {
+        histogram.Add(3);
+    }
+    histogram.Add(1000);
+    EXPECT_EQ(histogram.Count(), 101U);
+    EXPECT_EQ(histogram.Max(), 1000U);
+    EXPECT_EQ(histogram.Quantile(0.5), 3U);
+    EXPECT_EQ(histogram.Quantile(1.0), 1000U);
+}
+
+TEST(ProfileTest, CountsTagsSizesAndKeys) {
+    Dynamic d = Dynamic::From<Dynamic::Array>();
+    for (int i = 0; i < 10; ++i) {
+        d.GetArray().push_back(MakeRecord(i));
+    }
+
+    const auto profile = dynamicxx::Profile(d);
+    EXPECT_EQ(profile.documents, 1U);
+    EXPECT_EQ(profile.arrays, 11U);
+    EXPECT_EQ(profile.objects, 10U);
+    EXPECT_EQ(profile.integers, 10U);
+    EXPECT_EQ(profile.strings, 10U);
+    EXPECT_EQ(profile.booleans, 10U);
+    EXPECT_EQ(profile.numbers, 10U);
+    EXPECT_EQ(profile.Values(), 61U);
+    EXPECT_EQ(profile.MaxDepth(), 3U);
+    EXPECT_EQ(profile.object_sizes.Max(), 3U);
+    EXPECT_EQ(profile.array_lengths.Max(), 10U);
+    EXPECT_EQ(profile.string_lengths.Sum(), 40U);
+
+    EXPECT_EQ(profile.key_frequency.at("id"), 10U);
+    EXPECT_EQ(profile.TopKeys(1).size(), 1U);
+}
+
+TEST(ProfileTest, CountsViews) {
+    static const char kBuffer[] = "borrowed";
+
+    Dynamic d = Dynamic::From<Dynamic::Array>();
+    d.GetArray().push_back(
+        Dynamic::From<Dynamic::StringView>(kBuffer, sizeof(kBuffer) - 1));
+
+    const auto profile = dynamicxx::Profile(d);
+    EXPECT_EQ(profile.string_views, 1U);
+    EXPECT_EQ(profile.strings, 0U);
+    EXPECT_EQ(profile.string_lengths.Sum(), 8U);
+    EXPECT_EQ(profile.Values(), 2U);
+}
+
+TEST(ProfileTest, KeyTableIsBounded) {
+    dynamicxx::ProfileOptions options;
+    options.max_distinct_keys = 2;
+
+    Dynamic d = Dynamic::From<Dynamic::Object>();
+    for (int i = 0; i < 5; ++i) {
+        d[std::to_string(i).c_str()] = i;
+    }
+
+    const auto profile = dynamicxx::Profile(d, options);
+    EXPECT_EQ(profile.key_frequency.size(), 2U);
+    EXPECT_EQ(profile.untracked_keys, 3U);
+}
+
+TEST(ProfileTest, SamplerTakesEveryNth) {
+    dynamicxx::ProfileSampler sampler(4);
+    const auto record = MakeRecord(1);
+    for (int i = 0; i < 16; ++i) {
+        sampler.Offer(record);
+    }
+    EXPECT_EQ(sampler.Seen(), 16U);
+    EXPECT_EQ(sampler.GetProfile().documents, 4U);
+
+    dynamicxx::ShapeProfile merged;
+    merged.Merge(sampler.GetProfile());
+    merged.Merge(sampler.GetProfile());
+    EXPECT_EQ(merged.objects, 8U);
+    EXPECT_EQ(merged.key_frequency.at("level"), 8U);
+}
@@ -0,0 +1,190 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/queue.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using dynamicxx::Dynamic;
+using dynamicxx::DynamicManaged;
+using dynamicxx::IsTriviallyRelocatable;
+using dynamicxx::MpscQueue;
+using dynamicxx::SpscQueue;
+
+static_assert(IsTriviallyRelocatable<DynamicManaged>::value,
+              "A DynamicManaged is a single shared pointer");
+static_assert(!IsTriviallyRelocatable<Dynamic>::value,
+              "A Dynamic may hold a string that points into itself");
+
+namespace {
+
+Dynamic MakeMessage(const int id) {
+    Dynamic message = Dynamic::From<Dynamic::Object>();
+    message["id"] = id;
+    message["body"] = "payload " + std::to_string(id);
+    return message;
+}
+
+}  // namespace
+
+TEST(SpscQueueTest, IsBoundedAndFifo) {
+    EXPECT_THROW(SpscQueue<Dynamic>(0), std::invalid_argument);
+    SpscQueue<Dynamic> queue(3);
+    EXPECT_EQ(queue.capacity(), 4U);
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.TryPush(MakeMessage(i)));
+    }
+    EXPECT_FALSE(queue.TryPush(MakeMessage(4)));
+    EXPECT_EQ(queue.size(), 4U);
+
+    Dynamic out;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.TryPop(out));
+        EXPECT_EQ(out["id"].GetInteger(), i);
+        EXPECT_EQ(out["body"].GetString(), "payload " + std::to_string(i));
+    }
+    EXPECT_FALSE(queue.TryPop(out));
+    EXPECT_EQ(out["id"].GetInteger(), 3);
+}
+
+TEST(SpscQueueTest, MovesBatches) {
+    SpscQueue<Dynamic> queue(8);
+    std::vector<Dynamic> batch;
+    for (int i = 0; i < 10; ++i) {
+        batch.push_back(MakeMessage(i));
+    }
+    EXPECT_EQ(queue.TryPushBatch(batch.begin(), batch.size()), 8U);
+    EXPECT_EQ(queue.TryPushBatch(batch.begin() + 8, 2), 0U);
+
+    std::vector<Dynamic> received;
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(received), 5), 5U);
+    EXPECT_EQ(queue.TryPushBatch(batch.begin() + 8, 2), 2U);
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(received), 100), 5U);
+    ASSERT_EQ(received.size(), 10U);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(received[i]["id"].GetInteger(), i);
+    }
+}
+
+TEST(SpscQueueTest, DestroysWhatIsLeft) {
+    const auto tracked = std::make_shared<int>(0);
+    {
+        SpscQueue<std::shared_ptr<int>> queue(4);
+        EXPECT_TRUE(queue.TryPush(tracked));
+        EXPECT_TRUE(queue.TryPush(tracked));
+        EXPECT_EQ(tracked.use_count(), 3);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(SpscQueueTest, RelocatesManagedValues) {
+    SpscQueue<DynamicManaged> queue(2);
+    DynamicManaged message = DynamicManaged::From<DynamicManaged::Object>();
+    message["id"] = 7;
+    EXPECT_TRUE(queue.TryPush(message));
+    DynamicManaged out;
+    ASSERT_TRUE(queue.TryPop(out));
+    EXPECT_EQ(out["id"].GetInteger(), 7);
+    // The popped value shares the original's Impl.
+    out["id"] = 8;
+    EXPECT_EQ(message["id"].GetInteger(), 8);
+}
+
+TEST(SpscQueueTest, CrossesThreads) {
+    constexpr int Count = 100000;
+    SpscQueue<Dynamic> queue(1024);
+    std::thread producer([&queue] {
+        for (int i = 0; i < Count; ++i) {
+            auto message = Dynamic::Of(i);
+            while (!queue.TryPush(std::move(message))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    std::int64_t expected = 0;
+    std::vector<Dynamic> received;
+    while (expected < Count) {
+        received.clear();
+        if (queue.TryPopBatch(std::back_inserter(received), 64) == 0) {
+            std::this_thread::yield();
+        }
+        for (const auto& message : received) {
+            ASSERT_EQ(message.GetInteger(), expected);
+            ++expected;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, KeepsEachProducersOrder) {
+    constexpr int Producers = 4;
+    constexpr int PerProducer = 20000;
+    MpscQueue<Dynamic> queue(256);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < Producers; ++p) {
+        producers.emplace_back([&queue, p] {
+            std::vector<Dynamic> batch;
+            for (int i = 0; i < PerProducer;) {
+                batch.clear();
+                for (int j = 0; j < 16 && i + j < PerProducer; ++j) {
+                    batch.push_back(Dynamic::Of(p * PerProducer + i + j));
+                }
+                auto next = batch.begin();
+                while (next != batch.end()) {
+                    const auto pushed = queue.TryPushBatch(
+                        next, static_cast<std::size_t>(batch.end() - next));
+                    next += static_cast<std::ptrdiff_t>(pushed);
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+                i += static_cast<int>(batch.size());
+            }
+        });
+    }
+
+    std::vector<std::int64_t> next(Producers);
+    for (int p = 0; p < Producers; ++p) {
+        next[p] = p * PerProducer;
+    }
+    int received = 0;
+    Dynamic message;
+    while (received < Producers * PerProducer) {
+        if (!queue.TryPop(message)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const auto value = message.GetInteger();
+        const auto producer = value / PerProducer;
+        ASSERT_EQ(value, next[producer]);
+        ++next[producer];
+        ++received;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, IsBounded) {
+    MpscQueue<int> queue(2);
+    const std::vector<int> values = {1, 2, 3};
+    EXPECT_EQ(queue.TryPushBatch(values.begin(), values.size()), 2U);
+    EXPECT_FALSE(queue.TryEmplace(4));
+    std::vector<int> out;
+    EXPECT_EQ(queue.TryPopBatch(std::back_inserter(out), 8), 2U);
+    EXPECT_EQ(out, (std::vector<int>{1, 2}));
+    EXPECT_TRUE(queue.TryEmplace(4));
+    int value = 0;
+    EXPECT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, 4);
+    EXPECT_FALSE(queue.TryPop(value));
+}
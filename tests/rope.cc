@@ -0,0 +1,151 @@
+#include <dynamicxx/binary.h>
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/rope.h>
+#include <dynamicxx/utf8.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using dynamicxx::DynamicRope;
+using dynamicxx::Rope;
+
+TEST(RopeTest, AppendsStayBalanced) {
+    Rope rope;
+    std::string expected;
+    for (int i = 0; i < 20000; ++i) {
+        const std::string line = "line " + std::to_string(i) + "\n";
+        rope += line;
+        expected += line;
+    }
+
+    EXPECT_EQ(rope.size(), expected.size());
+    EXPECT_EQ(rope.ToString(), expected);
+    EXPECT_GT(rope.ChunkCount(), 1U);
+    // An AVL tree is at most 1.44 log2(n) high.
+    EXPECT_LE(rope.Height(),
+              1.45 * std::log2(static_cast<double>(rope.ChunkCount())) + 2);
+    EXPECT_EQ(rope[6], expected[6]);
+    EXPECT_EQ(rope.at(expected.size() - 2), expected[expected.size() - 2]);
+    EXPECT_THROW((void)rope.at(expected.size()), std::out_of_range);
+    EXPECT_EQ(rope[expected.size()], '\0');
+    EXPECT_EQ(Rope()[0], '\0');
+}
+
+TEST(RopeTest, ConcatenatesAndSlices) {
+    const std::string large(1000, 'a');
+    Rope rope = Rope(large) + Rope("-middle-") + Rope(std::string(1000, 'b'));
+    for (int i = 0; i < 50; ++i) {
+        rope = rope + Rope(large);
+    }
+    const std::string expected = rope.ToString();
+    ASSERT_EQ(expected.size(), 2008U + 50 * 1000);
+
+    const Rope slice = rope.Slice(990, 1030);
+    EXPECT_EQ(slice.ToString(), expected.substr(990, 1030));
+    EXPECT_EQ(rope.Slice(1000, 8), "-middle-");
+    EXPECT_EQ(rope.Slice(expected.size() - 3).size(), 3U);
+    EXPECT_TRUE(rope.Slice(expected.size()).empty());
+    EXPECT_THROW((void)rope.Slice(expected.size() + 1), std::out_of_range);
+
+    // Slicing shares the chunks instead of copying them.
+    const Rope head = rope.Slice(0, 1000);
+    EXPECT_EQ((*head.Chunks().begin()).data(),
+              (*rope.Chunks().begin()).data());
+}
+
+TEST(RopeTest, FlattensOnDemand) {
+    Rope rope("hello");
+    rope += std::string(200, ',');
+    rope += " world";
+    EXPECT_GT(rope.ChunkCount(), 1U);
+
+    const std::string expected = "hello" + std::string(200, ',') + " world";
+    EXPECT_EQ(std::string(rope.c_str()), expected);
+    EXPECT_EQ(rope.ChunkCount(), 1U);
+    const char* const flat = rope.data();
+    EXPECT_EQ(rope.c_str(), flat);
+
+    // A slice ending before its buffer ends is copied to be terminated.
+    Rope slice = Rope(expected).Slice(0, 5);
+    EXPECT_EQ(std::string(slice.c_str()), "hello");
+    EXPECT_STREQ(Rope().c_str(), "");
+}
+
+TEST(RopeTest, ChunksWriteWithoutFlattening) {
+    Rope rope;
+    for (int i = 0; i < 10; ++i) {
+        rope += std::string(300, static_cast<char>('0' + i));
+    }
+    ASSERT_GT(rope.ChunkCount(), 1U);
+
+    std::string gathered;
+    std::size_t chunks = 0;
+    for (const auto chunk : rope.Chunks()) {
+        gathered.append(chunk.data(), chunk.size());
+        ++chunks;
+    }
+    EXPECT_EQ(chunks, rope.ChunkCount());
+    EXPECT_EQ(gathered, rope.ToString());
+
+    std::ostringstream stream;
+    stream << rope;
+    EXPECT_EQ(stream.str(), gathered);
+    EXPECT_GT(rope.ChunkCount(), 1U);
+}
+
+TEST(RopeTest, ComparesAcrossChunkBoundaries) {
+    const Rope split = Rope(std::string(150, 'x')) + Rope(std::string(150, 'y'));
+    const Rope other = Rope(std::string(100, 'x')) +
+                       Rope(std::string(50, 'x') + std::string(150, 'y'));
+    EXPECT_EQ(split, other);
+    EXPECT_NE(split, other + Rope("z"));
+    EXPECT_LT(split, other + Rope("z"));
+    EXPECT_LT(Rope("abc"), Rope("abd"));
+}
+
+TEST(RopeTest, AsDynamicString) {
+    DynamicRope log = DynamicRope::From<DynamicRope::Object>();
+    log["messages"] = "started\n";
+    for (int i = 0; i < 1000; ++i) {
+        log["messages"].GetString() += "event\n";
+    }
+    ASSERT_TRUE(log["messages"].IsString());
+    EXPECT_EQ(log["messages"].GetString().size(), 8U + 6000U);
+
+    const DynamicRope copy = log.Clone();
+    EXPECT_EQ(copy, log);
+    // Viewing needs a single chunk, which only a non-const flatten makes.
+    EXPECT_THROW((void)copy["messages"].ToStringView(), std::logic_error);
+    log["messages"].GetString().Flatten();
+    EXPECT_EQ(log["messages"].ToStringView().size(), 6008U);
+
+    log["view"] = DynamicRope::StringView("started\n");
+    EXPECT_EQ(log["view"], DynamicRope::From<Rope>("started\n"));
+}
+
+TEST(RopeTest, ConstReadsDoNotFlatten) {
+    DynamicRope document = DynamicRope::From<DynamicRope::Array>();
+    document.Push("caf\xC3");
+    document.GetArray()[0].GetString() += "\xA9 ";
+    document.GetArray()[0].GetString() += std::string(200, 'x');
+    const DynamicRope& shared = document;
+    const auto& text = shared.GetArray()[0].GetString();
+    ASSERT_GT(text.ChunkCount(), 1U);
+
+    // A code point split across chunks is still valid.
+    EXPECT_NO_THROW(dynamicxx::Validate(shared));
+    const std::string flat = "caf\xC3\xA9 " + std::string(200, 'x');
+    EXPECT_EQ(shared.GetArray()[0],
+              DynamicRope::From<DynamicRope::StringView>(flat.c_str()));
+    EXPECT_EQ(dynamicxx::DecodeBinary<DynamicRope>(
+                  dynamicxx::EncodeBinary(shared))
+                  .GetArray()[0]
+                  .GetString()
+                  .ToString(),
+              flat);
+    EXPECT_GT(text.ChunkCount(), 1U);
+}
@@ -0,0 +1,149 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/shared_blob.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dynamicxx::DynamicSharedBlob;
+using dynamicxx::SharedBlob;
+
+TEST(SharedBlobTest, CopiesShareStorage) {
+    std::vector<std::uint8_t> bytes(1 << 20, 7);
+    const auto* const storage = bytes.data();
+
+    const SharedBlob<> blob(std::move(bytes));
+    EXPECT_EQ(blob.data(), storage);
+    EXPECT_EQ(blob.size(), 1U << 20);
+
+    const SharedBlob<> copy = blob;
+    EXPECT_TRUE(copy.SharesWith(blob));
+    EXPECT_EQ(blob.UseCount(), 2);
+}
+
+TEST(SharedBlobTest, Slices) {
+    const SharedBlob<> blob = {0, 1, 2, 3, 4, 5};
+
+    const auto middle = blob.Slice(2, 3);
+    EXPECT_EQ(middle.size(), 3U);
+    EXPECT_EQ(middle.data(), blob.data() + 2);
+    EXPECT_EQ(middle[0], 2);
+    EXPECT_EQ(middle, (SharedBlob<>{2, 3, 4}));
+
+    EXPECT_EQ(blob.Slice(4).size(), 2U);
+    EXPECT_EQ(blob.Slice(6).size(), 0U);
+    EXPECT_THROW((void)blob.Slice(7), std::out_of_range);
+
+    // A slice keeps the whole buffer alive.
+    SharedBlob<> tail;
+    {
+        const SharedBlob<> temporary = {9, 8, 7};
+        tail = temporary.Slice(1);
+    }
+    EXPECT_EQ(tail, (SharedBlob<>{8, 7}));
+}
+
+TEST(SharedBlobTest, Adopt) {
+    static const std::uint8_t kBytes[] = {1, 2, 3};
+    bool released = false;
+    {
+        const std::shared_ptr<bool> owner(&released,
+                                          [](bool* flag) { *flag = true; });
+        const auto blob = SharedBlob<>::Adopt(owner, kBytes, sizeof(kBytes));
+        EXPECT_EQ(blob.data(), kBytes);
+    }
+    EXPECT_TRUE(released);
+}
+
+TEST(SharedBlobTest, DocumentCopiesDoNotCopyBytes) {
+    DynamicSharedBlob envelope =
+        DynamicSharedBlob::From<DynamicSharedBlob::Object>();
+    envelope["payload"] = DynamicSharedBlob::Blob(
+        std::vector<std::uint8_t>(4096, 1));
+    envelope["header"] = DynamicSharedBlob::Blob{1, 2};
+
+    const DynamicSharedBlob copy = envelope;
+    const DynamicSharedBlob clone = envelope.Clone();
+    EXPECT_TRUE(copy["payload"].GetBlob().SharesWith(
+        envelope["payload"].GetBlob()));
+    EXPECT_TRUE(clone["payload"].GetBlob().SharesWith(
+        envelope["payload"].GetBlob()));
+    EXPECT_EQ(clone, envelope);
+
+    std::vector<dynamicxx::IoSlice> slices;
+    dynamicxx::CollectIoSlices(envelope, slices);
+    ASSERT_EQ(slices.size(), 2U);
+    std::size_t total = 0;
+    for (const auto& slice : slices) {
+        total += slice.size;
+    }
+    EXPECT_EQ(total, 4098U);
+}
+
+TEST(SharedBlobTest, MaterializeViewsIntoSharedBlobs) {
+    const std::vector<std::uint8_t> buffer = {5, 6, 7};
+    DynamicSharedBlob value =
+        DynamicSharedBlob::From<DynamicSharedBlob::BlobView>(buffer);
+    value.Materialize();
+    ASSERT_TRUE(value.IsBlob());
+    EXPECT_NE(value.GetBlob().data(), buffer.data());
+    EXPECT_EQ(value.GetBlob(), (SharedBlob<>{5, 6, 7}));
+}
+
+namespace {
+
+// A file of `size` bytes where byte i holds i % 251, so that offsets are
+// visible in the contents.
+std::string WritePatternFile(const std::string& name, const std::size_t size) {
+    const auto path = ::testing::TempDir() + name;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    for (std::size_t i = 0; i < size; ++i) {
+        file.put(static_cast<char>(i % 251));
+    }
+    return path;
+}
+
+}  // namespace
+
+TEST(SharedBlobTest, FromFileMapsRanges) {
+    const auto path = WritePatternFile("dynamicxx_shared_blob_map", 10000);
+
+    const auto whole = SharedBlob<>::FromFile(path);
+    ASSERT_EQ(whole.size(), 10000U);
+    EXPECT_EQ(whole[9999], 9999 % 251);
+
+    // Offsets need not be page aligned.
+    const auto range = SharedBlob<>::FromFile(path, 5000, 100);
+    ASSERT_EQ(range.size(), 100U);
+    EXPECT_EQ(range[0], 5000 % 251);
+    EXPECT_EQ(range.Slice(99)[0], 5099 % 251);
+
+    EXPECT_EQ(SharedBlob<>::FromFile(path, 10000).size(), 0U);
+    EXPECT_THROW((void)SharedBlob<>::FromFile(path, 10001), std::out_of_range);
+    EXPECT_THROW((void)SharedBlob<>::FromFile(path, 9000, 2000),
+                 std::out_of_range);
+    EXPECT_THROW((void)SharedBlob<>::FromFile(path + ".missing"),
+                 std::runtime_error);
+}
+
+TEST(SharedBlobTest, BlobFromFile) {
+    const auto path = WritePatternFile("dynamicxx_shared_blob_dynamic", 4096);
+
+    const auto mapped = dynamicxx::BlobFromFile<DynamicSharedBlob>(path, 1, 10);
+    ASSERT_TRUE(mapped.IsBlob());
+    EXPECT_EQ(mapped.GetBlob()[0], 1);
+
+    // Vector blobs read the same range instead of mapping it.
+    const auto read = dynamicxx::BlobFromFile<dynamicxx::Dynamic>(path, 1, 10);
+    ASSERT_TRUE(read.IsBlob());
+    EXPECT_EQ(read.GetBlob().size(), 10U);
+    EXPECT_EQ(read.GetBlob()[9], 10);
+    EXPECT_EQ(read.ToBlobView(), mapped.ToBlobView());
+    EXPECT_THROW((void)dynamicxx::BlobFromFile<dynamicxx::Dynamic>(path, 5000),
+                 std::out_of_range);
+}
@@ -0,0 +1,131 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/ordered_map.h>
+#include <dynamicxx/shared_memory.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dynamicxx::Dynamic;
+using dynamicxx::Freeze;
+using dynamicxx::OffsetPtr;
+using dynamicxx::ReadSegment;
+using dynamicxx::SegmentArena;
+using dynamicxx::SharedValue;
+
+namespace {
+
+Dynamic MakeState() {
+    Dynamic state = Dynamic::From<Dynamic::Object>();
+    state["name"] = "sidecar";
+    state["pid"] = 4242;
+    state["load"] = 0.75;
+    state["healthy"] = true;
+    state["nothing"] = Dynamic::From<Dynamic::Null>();
+    state["weights"] = Dynamic::Blob{1, 2, 3};
+    state["routes"] = Dynamic::From<Dynamic::Array>();
+    for (int i = 0; i < 100; ++i) {
+        Dynamic route = Dynamic::From<Dynamic::Object>();
+        route["id"] = i;
+        route["path"] = "/api/v1/" + std::to_string(i);
+        state["routes"].GetArray().push_back(std::move(route));
+    }
+    state["empty"] = Dynamic::From<Dynamic::Object>();
+    return state;
+}
+
+}  // namespace
+
+TEST(OffsetPtrTest, IsRelativeToItself) {
+    struct Pair {
+        int value = 42;
+        OffsetPtr<int> pointer;
+    };
+    std::vector<unsigned char> first(sizeof(Pair));
+    auto* pair = new (first.data()) Pair;
+    pair->pointer = &pair->value;
+    EXPECT_EQ(*pair->pointer, 42);
+
+    // The bytes still point at the value after a move to another address.
+    std::vector<unsigned char> second(first);
+    auto* moved = reinterpret_cast<Pair*>(second.data());
+    EXPECT_EQ(moved->pointer.get(), &moved->value);
+
+    // Copies are re-based.
+    const OffsetPtr<int> copy = pair->pointer;
+    EXPECT_EQ(copy.get(), &pair->value);
+    EXPECT_FALSE(OffsetPtr<int>());
+    EXPECT_EQ(OffsetPtr<int>(nullptr).get(), nullptr);
+}
+
+TEST(SharedMemoryTest, FreezesAndReadsInPlace) {
+    const auto state = MakeState();
+    std::vector<std::uint64_t> segment(64 * 1024 / sizeof(std::uint64_t));
+    const auto size = segment.size() * sizeof(std::uint64_t);
+    SegmentArena arena(segment.data(), size);
+    EXPECT_THROW((void)ReadSegment(segment.data(), size), std::runtime_error);
+    arena.Publish(Freeze(state, arena));
+
+    // Read from a copy at another address, as another process would.
+    const auto copy = segment;
+    const auto root = ReadSegment(copy.data(), size);
+    ASSERT_TRUE(root.IsObject());
+    EXPECT_EQ(root.size(), 8U);
+    EXPECT_EQ(root["name"].GetString(), SharedValue::StringView("sidecar"));
+    EXPECT_EQ(root["pid"].GetInteger(), 4242);
+    EXPECT_EQ(root["load"].GetNumber(), 0.75);
+    EXPECT_TRUE(root["healthy"].GetBoolean());
+    EXPECT_TRUE(root["nothing"].IsNull());
+    EXPECT_EQ(root["weights"].GetBlob().size(), 3U);
+    EXPECT_EQ(root["routes"].size(), 100U);
+    EXPECT_EQ(root["routes"][57]["path"].GetString(),
+              SharedValue::StringView("/api/v1/57"));
+    EXPECT_EQ(root["empty"].size(), 0U);
+    EXPECT_TRUE(root.Contains("pid"));
+    EXPECT_FALSE(root.Contains("missing"));
+    EXPECT_THROW((void)root["missing"], std::out_of_range);
+    EXPECT_THROW((void)root["routes"][100], std::out_of_range);
+    EXPECT_THROW((void)root["pid"].GetString(),
+                 dynamicxx::InvalidAccessException);
+
+    // Keys are in sorted order.
+    EXPECT_EQ(root.KeyAt(0), SharedValue::StringView("empty"));
+    EXPECT_EQ(root.KeyAt(7), SharedValue::StringView("weights"));
+
+    EXPECT_EQ(root.Thaw<Dynamic>(), state);
+    const auto ordered = root.Thaw<dynamicxx::OrderedDynamic>();
+    EXPECT_EQ(ordered["routes"][3]["path"].GetString(), "/api/v1/3");
+}
+
+TEST(SharedMemoryTest, FailsWhenFull) {
+    std::vector<std::uint64_t> segment(32);
+    SegmentArena arena(segment.data(), segment.size() * 8);
+    EXPECT_THROW((void)Freeze(MakeState(), arena), std::bad_alloc);
+    EXPECT_THROW(SegmentArena(segment.data(), 8), std::invalid_argument);
+}
+
+#if DYNAMICXX_HAS_MMAP
+TEST(SharedMemoryTest, PosixSharedMemory) {
+    const std::string name =
+        "/dynamicxx-test-" + std::to_string(static_cast<long>(::getpid()));
+    dynamicxx::SharedMemory::Unlink(name);
+    {
+        auto writer = dynamicxx::SharedMemory::Create(name, 1 << 20);
+        SegmentArena arena(writer.Data(), writer.size());
+        arena.Publish(Freeze(MakeState(), arena));
+
+        const auto reader = dynamicxx::SharedMemory::Open(name);
+        EXPECT_NE(reader.Data(), writer.Data());
+        const auto root = ReadSegment(reader.Data(), reader.size());
+        EXPECT_EQ(root["routes"][99]["id"].GetInteger(), 99);
+        EXPECT_THROW(dynamicxx::SharedMemory::Create(name, 1024),
+                     std::system_error);
+    }
+    dynamicxx::SharedMemory::Unlink(name);
+    EXPECT_THROW(dynamicxx::SharedMemory::Open(name), std::system_error);
+}
+#endif
@@ -0,0 +1,124 @@
+#include <dynamicxx/dynamicxx.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#if !DYNAMICXX_TRACE
+#error "The trace tests must be built with DYNAMICXX_TRACE=1"
+#endif
+
+using dynamicxx::Dynamic;
+using dynamicxx::TraceEvent;
+using dynamicxx::TraceRecord;
+
+namespace {
+
+class TraceTest : public ::testing::Test {
+   protected:
+    void SetUp() override { dynamicxx::SetTraceSink(&sink_); }
+    void TearDown() override { dynamicxx::SetTraceSink(nullptr); }
+
+    std::size_t CountOf(const TraceEvent event) const {
+        const auto records = sink_.Snapshot();
+        return static_cast<std::size_t>(
+            std::count_if(records.begin(), records.end(),
+                          [event](const TraceRecord& record) {
+                              return record.event == event;
+                          }));
+    }
+
+    dynamicxx::TraceRingBuffer<1024> sink_;
+};
+
+Dynamic MakeLargeArray() {
+    Dynamic d = Dynamic::From<Dynamic::Array>();
+    for (int i = 0; i < DYNAMICXX_TRACE_LARGE_SIZE; ++i) {
+        d.Push(i);
+    }
+    return d;
+}
+
+}  // namespace
+
+TEST_F(TraceTest, GrowthIsReported) {
+    const auto d = MakeLargeArray();
+    EXPECT_GT(CountOf(TraceEvent::Growth), 0U);
+    // Amortized growth: far fewer reallocations than pushes.
+    EXPECT_LT(CountOf(TraceEvent::Growth), d.size() / 8);
+}
+
+TEST_F(TraceTest, ImplicitDeepCopyIsReported) {
+    const auto d = MakeLargeArray();
+    ASSERT_EQ(CountOf(TraceEvent::DeepCopy), 0U);
+
+    const Dynamic copy = d;
+    EXPECT_EQ(CountOf(TraceEvent::DeepCopy), 1U);
+    EXPECT_EQ(sink_.Snapshot().back().size, d.size());
+}
+
+TEST_F(TraceTest, NestedValuesCountTowardsTheSubtree) {
+    // No single array is large, but the outer one holds a large subtree.
+    Dynamic d = Dynamic::From<Dynamic::Array>();
+    for (int i = 0; i < 4; ++i) {
+        Dynamic inner = Dynamic::From<Dynamic::Array>();
+        for (int j = 0; j < DYNAMICXX_TRACE_LARGE_SIZE / 4; ++j) {
+            inner.Push(j);
+        }
+        d.GetArray().push_back(std::move(inner));
+    }
+
+    const Dynamic copy = d;
+    EXPECT_EQ(CountOf(TraceEvent::DeepCopy), 1U);
+    EXPECT_EQ(sink_.Snapshot().back().size,
+              static_cast<std::size_t>(4 + DYNAMICXX_TRACE_LARGE_SIZE / 4 * 4));
+}
+
+TEST_F(TraceTest, OnlyTheOutermostValueIsReported) {
+    {
+        Dynamic d = Dynamic::From<Dynamic::Array>();
+        d.GetArray().push_back(MakeLargeArray());
+        d.GetArray().push_back(MakeLargeArray());
+        const Dynamic copy = d;
+        EXPECT_EQ(CountOf(TraceEvent::DeepCopy), 1U);
+        EXPECT_EQ(sink_.Snapshot().back().size,
+                  static_cast<std::size_t>(2 + 2 * DYNAMICXX_TRACE_LARGE_SIZE));
+    }
+    // d and copy; the inner arrays are destroyed as part of them.
+    EXPECT_EQ(CountOf(TraceEvent::Destroy), 2U);
+
+    // A deep chain is measured once per copy, not once per level.
+    Dynamic chain = Dynamic::From<Dynamic::Array>();
+    for (int i = 0; i < 2 * DYNAMICXX_TRACE_LARGE_SIZE; ++i) {
+        Dynamic link = Dynamic::From<Dynamic::Array>();
+        link.GetArray().push_back(std::move(chain));
+        chain = std::move(link);
+    }
+    const Dynamic copy = chain;
+    EXPECT_EQ(CountOf(TraceEvent::DeepCopy), 2U);
+}
+
+TEST_F(TraceTest, SmallCopiesAreNotReported) {
+    Dynamic d = Dynamic::From<Dynamic::Array>();
+    d.Push(1);
+    const Dynamic copy = d;
+    EXPECT_EQ(CountOf(TraceEvent::DeepCopy), 0U);
+}
+
+TEST_F(TraceTest, CloneAndDestroyAreReported) {
+    {
+        const auto d = MakeLargeArray();
+        const auto clone = d.Clone();
+        EXPECT_EQ(CountOf(TraceEvent::Clone), 1U);
+        EXPECT_EQ(CountOf(TraceEvent::Destroy), 0U);
+    }
+    EXPECT_EQ(CountOf(TraceEvent::Destroy), 2U);
+}
+
+TEST_F(TraceTest, InvalidAccessIsReported) {
+    const auto d = Dynamic::From<Dynamic::Integer>(42);
+    EXPECT_ANY_THROW(static_cast<void>(d.GetString()));
+    EXPECT_EQ(CountOf(TraceEvent::InvalidAccess), 1U);
+}
@@ -0,0 +1,129 @@
+#include <dynamicxx/dynamicxx.h>
+#include <dynamicxx/utf8.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+using dynamicxx::Dynamic;
+using dynamicxx::FindInvalidUtf8;
+using dynamicxx::InvalidEncodingException;
+using dynamicxx::IsValidUtf8;
+
+namespace {
+
+std::string Encode(const std::uint32_t code_point) {
+    std::string text;
+    if (code_point < 0x80) {
+        text += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+        text += static_cast<char>(0xC0 | (code_point >> 6));
+        text += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        text += static_cast<char>(0xE0 | (code_point >> 12));
+        text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        text += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+        text += static_cast<char>(0xF0 | (code_point >> 18));
+        text += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        text += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+    return text;
+}
+
+}  // namespace
+
+TEST(Utf8Test, AcceptsEveryScalarValue) {
+    for (std::uint32_t code_point = 0; code_point <= 0x10FFFF; ++code_point) {
+        if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+            EXPECT_FALSE(IsValidUtf8(Encode(code_point))) << code_point;
+            continue;
+        }
+        const auto text = Encode(code_point);
+        ASSERT_TRUE(IsValidUtf8(text)) << code_point;
+    }
+}
+
+TEST(Utf8Test, FindsIllFormedSequences) {
+    const std::string padding(37, 'a');
+    const char* const invalid[] = {
+        "\x80",              // Stray continuation byte.
+        "\xC0\x80",          // Overlong U+0000.
+        "\xC1\xBF",          // Overlong U+007F.
+        "\xE0\x80\x80",      // Overlong U+0000.
+        "\xE0\x9F\xBF",      // Overlong U+07FF.
+        "\xF0\x8F\xBF\xBF",  // Overlong U+FFFF.
+        "\xF4\x90\x80\x80",  // U+110000.
+        "\xF5\x80\x80\x80",  // Invalid lead byte.
+        "\xFF",              // Invalid lead byte.
+        "\xE2\x82",          // Truncated.
+        "\xE2\x28\xA1",      // Bad continuation byte.
+    };
+    for (const char* sequence : invalid) {
+        const auto text = padding + "\xC3\xA9" + sequence + padding;
+        EXPECT_EQ(FindInvalidUtf8(text.data(), text.size()),
+                  padding.size() + 2)
+            << sequence;
+    }
+
+    const auto valid = padding + "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" +
+                       padding + padding;
+    EXPECT_EQ(FindInvalidUtf8(valid.data(), valid.size()), valid.size());
+    EXPECT_TRUE(IsValidUtf8(""));
+}
+
+TEST(Utf8Test, TranscodesUtf16) {
+    const std::string text = "price: \xE2\x82\xAC" "5 \xF0\x9F\x98\x80 caf\xC3\xA9";
+    const auto utf16 = dynamicxx::Utf8ToUtf16(text);
+    EXPECT_EQ(utf16, u"price: €5 \U0001F600 café");
+    EXPECT_EQ(dynamicxx::Utf16ToUtf8(utf16), text);
+
+    try {
+        (void)dynamicxx::Utf8ToUtf16(std::string("ok\xED\xA0\x80"));
+        FAIL();
+    } catch (const InvalidEncodingException& error) {
+        EXPECT_EQ(error.Offset(), 2U);
+    }
+    const char16_t unpaired[] = {u'a', 0xD83D, u'b'};
+    EXPECT_THROW((void)dynamicxx::Utf16ToUtf8(unpaired, 3),
+                 InvalidEncodingException);
+    const char16_t reversed[] = {0xDE00, 0xD83D};
+    EXPECT_THROW((void)dynamicxx::Utf16ToUtf8(reversed, 2),
+                 InvalidEncodingException);
+}
+
+TEST(Utf8Test, TranscodesLatin1) {
+    std::string latin1;
+    for (int byte = 1; byte < 256; ++byte) {
+        latin1 += static_cast<char>(byte);
+    }
+    const auto utf8 = dynamicxx::Latin1ToUtf8(latin1);
+    EXPECT_TRUE(IsValidUtf8(utf8));
+    EXPECT_EQ(utf8.size(), 127U + 2 * 128U);
+    EXPECT_EQ(dynamicxx::Utf8ToLatin1(utf8), latin1);
+
+    EXPECT_THROW((void)dynamicxx::Utf8ToLatin1("\xE2\x82\xAC"),
+                 InvalidEncodingException);
+}
+
+TEST(Utf8Test, ValidatesDocuments) {
+    Dynamic document = Dynamic::From<Dynamic::Object>();
+    document["name"] = "caf\xC3\xA9";
+    document["tags"] = Dynamic::From<Dynamic::Array>();
+    document["tags"].Push(Dynamic::StringView("ok"));
+    document["raw"] = Dynamic::Blob{0xFF, 0xFE};
+    EXPECT_NO_THROW(dynamicxx::Validate(document));
+
+    document["tags"].Push("bad\xC3");
+    try {
+        dynamicxx::Validate(document);
+        FAIL();
+    } catch (const InvalidEncodingException& error) {
+        EXPECT_EQ(error.Offset(), 3U);
+    }
+
+    Dynamic keys = Dynamic::From<Dynamic::Object>();
+    keys["\xFFkey"] = 1;
+    EXPECT_THROW(dynamicxx::Validate(keys), InvalidEncodingException);
+}
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Generates include/dynamicxx/pow5_table.h for the Eisel-Lemire parser.
+
+For every decimal exponent q in [-342, 308], the table holds the 128 most
+significant bits of 5^q, normalized so that the top bit is set: truncated for
+q >= 0, and rounded up for q < 0 so that the parser's product never
+underestimates. These are the constants of the published algorithm.
+
+Usage:
+    generate_pow5_table.py > include/dynamicxx/pow5_table.h
+"""
+
+import sys
+
+SMALLEST = -342
+LARGEST = 308
+
+HEADER = """\
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Generated by tools/generate_pow5_table.py. Do not edit.
+
+#ifndef DYNAMICXX_POW5_TABLE_H
+#define DYNAMICXX_POW5_TABLE_H
+
+#include <cstdint>
+
+namespace dynamicxx {
+namespace detail {
+namespace numeric {
+
+constexpr int SmallestPowerOfFive = %d;
+constexpr int LargestPowerOfFive = %d;
+
+// High and low 64 bits of 5^q for q from SmallestPowerOfFive.
+inline const std::uint64_t* PowersOfFive() noexcept {
+    static const std::uint64_t table[] = {
+"""
+
+FOOTER = """\
+    };
+    return table;
+}
+
+}  // namespace numeric
+}  // namespace detail
+}  // namespace dynamicxx
+
+#endif  // DYNAMICXX_POW5_TABLE_H
+"""
+
+
+def power(q):
+    if q >= 0:
+        value = 5**q
+        while value < (1 << 127):
+            value *= 2
+        while value >= (1 << 128):
+            value //= 2
+        return value
+    value = 5**-q
+    bits = value.bit_length()
+    if q >= -27:
+        result = (1 << (bits + 127)) // value + 1
+    else:
+        result = (1 << (2 * bits + 128)) // value + 1
+    while result >= (1 << 128):
+        result //= 2
+    return result
+
+
+def main():
+    out = [HEADER % (SMALLEST, LARGEST)]
+    for q in range(SMALLEST, LARGEST + 1):
+        value = power(q)
+        out.append("        0x{:016x}U, 0x{:016x}U,  // 5^{}\n".format(
+            value >> 64, value & ((1 << 64) - 1), q))
+    out.append(FOOTER)
+    sys.stdout.write("".join(out))
+
+
+if __name__ == "__main__":
+    main()